@@ -0,0 +1,356 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "BatchRunner.hpp"
+#include "GPTDisplay.hpp"
+#include "config.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string.h>
+
+#ifndef WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+static string manifestPath(const string &dir, const string &file) {
+  if (file.empty() || (file[0] == '/')) {
+    return file;
+  }
+  return dir + file;
+}
+
+static void jsonString(ostream &out, const string &str) {
+  out << '"';
+  for (string::size_type i = 0; i < str.length(); i++) {
+    unsigned char c = str[i];
+    switch (c) {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    case '\r':
+      out << "\\r";
+      break;
+    case '\t':
+      out << "\\t";
+      break;
+    default:
+      if (c < 0x20) {
+        out << "\\u" << hex << setw(4) << setfill('0') << (int)c << dec
+            << setfill(' ');
+      } else {
+        out << c;
+      }
+    }
+  }
+  out << '"';
+}
+
+bool BatchRunner::readManifest(const string &file) {
+  stringstream s;
+  ifstream in(file.c_str());
+  if (!in) {
+    s << PACKAGE << ": não foi possível abrir o arquivo: \"" << file << "\""
+      << endl;
+    GPTDisplay::showError(s);
+    return false;
+  }
+
+  string dir;
+  string::size_type sep = file.rfind('/');
+  if (sep != string::npos) {
+    dir = file.substr(0, sep + 1);
+  }
+
+  vector<Case> read;
+  string line;
+  for (int n = 1; getline(in, line); n++) {
+    stringstream words(line);
+    string cmd;
+    string arg;
+    if (!(words >> cmd) || (cmd[0] == '#')) {
+      continue;
+    }
+
+    if (cmd == "programa") {
+      Program p;
+      p.ok = false;
+      while (words >> arg) {
+        p.name += (p.name.empty() ? "" : " ") + arg;
+        p.files.push_back(manifestPath(dir, arg));
+      }
+      if (p.files.empty()) {
+        s << file << ":" << n << " - faltando arquivo do algoritmo" << endl;
+        goto bail;
+      }
+      programs.push_back(p);
+    } else if (cmd == "entrada") {
+      if (programs.empty()) {
+        s << file << ":" << n << " - entrada declarada antes de um programa"
+          << endl;
+        goto bail;
+      }
+      if (!(words >> arg)) {
+        s << file << ":" << n << " - faltando arquivo de entrada" << endl;
+        goto bail;
+      }
+      Case c;
+      c.program = programs.size() - 1;
+      c.name = arg;
+      c.input = manifestPath(dir, arg);
+      if (!ifstream(c.input.c_str())) {
+        s << file << ":" << n << " - não foi possível abrir o arquivo: \""
+          << arg << "\"" << endl;
+        goto bail;
+      }
+      read.push_back(c);
+    } else {
+      s << file << ":" << n << " - comando inválido: \"" << cmd << "\""
+        << endl;
+      goto bail;
+    }
+  }
+
+  // programas sem entradas sao executados uma vez, com a entrada vazia
+  for (unsigned p = 0; p < programs.size(); p++) {
+    bool found = false;
+    for (unsigned i = 0; i < read.size(); i++) {
+      if (read[i].program == (int)p) {
+        cases.push_back(read[i]);
+        found = true;
+      }
+    }
+    if (!found) {
+      Case c;
+      c.program = p;
+      cases.push_back(c);
+    }
+  }
+  return true;
+
+bail:
+  GPTDisplay::showError(s);
+  return false;
+}
+
+#ifndef WIN32
+// arquivo temporario para as saidas de um caso
+static int createTmpFile(string &path) {
+  char name[] = "/tmp/gpt_batch_XXXXXX";
+  int fd = mkstemp(name);
+  path = name;
+  return fd;
+}
+
+static string readAll(int fd) {
+  string str;
+  char buffer[64 * 1024];
+  int n;
+  lseek(fd, 0, SEEK_SET);
+  while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+    str.append(buffer, n);
+  }
+  close(fd);
+  return str;
+}
+#endif
+
+void BatchRunner::run(int jobs, const Executor &exec) {
+#ifdef WIN32
+  stringstream s;
+  s << PACKAGE << ": modo --batch não disponível nesta plataforma" << endl;
+  GPTDisplay::showError(s);
+#else
+  struct Worker {
+    unsigned c;
+    int out;
+    int err;
+    string stats;
+    chrono::steady_clock::time_point started;
+  };
+
+  map<pid_t, Worker> running;
+  unsigned next = 0;
+
+  for (;;) {
+    while (((int)running.size() < jobs) && (next < cases.size())) {
+      Case &c = cases[next];
+      Worker w;
+      w.c = next++;
+
+      if (!programs[c.program].ok) {
+        c.result = "erro_compilacao";
+        c.exitCode = EXIT_FAILURE;
+        c.err = programs[c.program].errors;
+        continue;
+      }
+
+      string path;
+      w.out = createTmpFile(path);
+      unlink(path.c_str());
+      w.err = createTmpFile(path);
+      unlink(path.c_str());
+      close(createTmpFile(w.stats));
+
+      // evita que dados pendentes do pai sejam escritos pelos filhos
+      fflush(0);
+
+      w.started = chrono::steady_clock::now();
+      pid_t pid = fork();
+      if (pid == 0) {
+        int in = open(c.input.empty() ? "/dev/null" : c.input.c_str(),
+                      O_RDONLY);
+        if ((in < 0) || (w.out < 0) || (w.err < 0)) {
+          _exit(EXIT_FAILURE);
+        }
+        dup2(in, 0);
+        dup2(w.out, 1);
+        dup2(w.err, 2);
+        close(in);
+
+        ofstream stats(w.stats.c_str());
+        // erros de execucao e limites excedidos terminam o processo aqui
+        // mesmo (exit), apos gravar as estatisticas
+        exit(exec(c.program, stats));
+      }
+
+      if (pid < 0) {
+        c.result = "erro";
+        c.exitCode = EXIT_FAILURE;
+        c.err = string("fork: ") + strerror(errno);
+        close(w.out);
+        close(w.err);
+        unlink(w.stats.c_str());
+        continue;
+      }
+      running[pid] = w;
+    }
+
+    if (running.empty()) {
+      break;
+    }
+
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    map<pid_t, Worker>::iterator it = running.find(pid);
+    if (it == running.end()) {
+      continue;
+    }
+
+    Worker &w = it->second;
+    Case &c = cases[w.c];
+    c.time = chrono::duration<double>(chrono::steady_clock::now() - w.started)
+                 .count();
+    c.out = readAll(w.out);
+    c.err = readAll(w.err);
+
+    ifstream stats(w.stats.c_str());
+    getline(stats, c.stats);
+    stats.close();
+    unlink(w.stats.c_str());
+
+    finish(c, status);
+    running.erase(it);
+  }
+#endif
+}
+
+void BatchRunner::finish(Case &c, int status) {
+#ifndef WIN32
+  if (WIFSIGNALED(status)) {
+    c.exitCode = 128 + WTERMSIG(status);
+    c.result = "sinal";
+    return;
+  }
+  c.exitCode = WEXITSTATUS(status);
+#endif
+
+  // o interpretador informa como a execucao terminou (ok, erro ou limite)
+  string key = "\"resultado\": \"";
+  string::size_type p = c.stats.find(key);
+  if (p == string::npos) {
+    c.result = "erro";
+    return;
+  }
+  p += key.length();
+  c.result = c.stats.substr(p, c.stats.find('"', p) - p);
+}
+
+bool BatchRunner::write(const string &file) {
+  if (file.empty() || (file == "-")) {
+    for (unsigned i = 0; i < cases.size(); i++) {
+      writeCase(cout, cases[i]);
+    }
+    cout.flush();
+    return true;
+  }
+
+  ofstream out(file.c_str());
+  if (!out) {
+    stringstream s;
+    s << PACKAGE << ": não foi possível abrir o arquivo: \"" << file << "\""
+      << endl;
+    GPTDisplay::showError(s);
+    return false;
+  }
+  for (unsigned i = 0; i < cases.size(); i++) {
+    writeCase(out, cases[i]);
+  }
+  return true;
+}
+
+void BatchRunner::writeCase(ostream &out, const Case &c) {
+  out << "{\"programa\": ";
+  jsonString(out, programs[c.program].name);
+  out << ", \"entrada\": ";
+  jsonString(out, c.name);
+  out << ", \"resultado\": \"" << c.result << "\""
+      << ", \"codigo_saida\": " << c.exitCode << ", \"tempo\": " << fixed
+      << setprecision(6) << c.time << ", \"saida\": ";
+  jsonString(out, c.out);
+  out << ", \"erros\": ";
+  jsonString(out, c.err);
+  if (!c.stats.empty()) {
+    out << ", \"estatisticas\": " << c.stats;
+  }
+  out << "}" << endl;
+}
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef BATCHRUNNER_HPP
+#define BATCHRUNNER_HPP
+
+#include <functional>
+#include <list>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// modo --batch: le um manifesto com algoritmos e arquivos de entrada e
+// executa cada caso em um processo filho (fork), com no maximo "jobs"
+// processos simultaneos. Os algoritmos sao analisados uma unica vez, pelo
+// processo pai, antes das execucoes. O resultado de todos os casos e'
+// gravado em um unico arquivo, uma linha JSON por caso.
+//
+// Formato do manifesto (caminhos relativos ao diretorio do manifesto):
+//
+//   # comentario
+//   programa exercicio.gpt [outro.gpt...]
+//   entrada casos/1.in
+//   entrada casos/2.in
+class BatchRunner {
+public:
+  struct Program {
+    string name;        // como escrito no manifesto
+    list<string> files; // arquivos do algoritmo
+    bool ok;            // analisado sem erros
+    string errors;      // mensagens da analise, se !ok
+  };
+
+  struct Case {
+    Case() : program(0), exitCode(0), time(0) {}
+
+    int program; // indice em programs
+    string name; // como escrito no manifesto
+    string input;
+
+    string result; // ok, erro, limite, sinal ou erro_compilacao
+    int exitCode;
+    double time; // segundos (tempo real)
+    string out;
+    string err;
+    string stats; // objeto JSON de RuntimeStats
+  };
+
+  // executado no processo filho, com a entrada e as saidas padrao ja
+  // redirecionadas. Deve habilitar as estatisticas em "stats" (ver
+  // InterpreterEval::enableStats) e retornar o codigo de saida do algoritmo.
+  typedef function<int(int program, ostream &stats)> Executor;
+
+  bool readManifest(const string &file);
+
+  void run(int jobs, const Executor &exec);
+
+  bool write(const string &file);
+
+  vector<Program> programs;
+  vector<Case> cases;
+
+private:
+  void finish(Case &c, int status);
+  void writeCase(ostream &out, const Case &c);
+};
+
+#endif
@@ -0,0 +1,226 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "BuildCache.hpp"
+#include "LibraryCache.hpp"
+#include "config.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#ifndef WIN32
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+static bool readFile(const string &file, string &data) {
+  ifstream fi(file.c_str(), ios_base::in | ios_base::binary);
+  if (!fi) {
+    return false;
+  }
+  stringstream s;
+  s << fi.rdbuf();
+  data = s.str();
+  return true;
+}
+
+#ifndef WIN32
+// mkdir -p
+static bool makeDirs(const string &dir) {
+  for (string::size_type p = 1; p != string::npos;) {
+    p = dir.find('/', p + 1);
+    string d = dir.substr(0, p);
+    if ((mkdir(d.c_str(), 0755) != 0) && (errno != EEXIST)) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
+#ifndef WIN32
+// identifica o executavel em uso (e os geradores de codigo ligados a ele):
+// um gpt recompilado, mesmo com a mesma versao, nao reaproveita entradas
+// geradas pelo anterior. Vazia se o executavel nao puder ser encontrado
+static string buildId() {
+  const char *exe[] = {"/proc/self/exe", "/proc/curproc/file"};
+  struct stat st;
+  for (unsigned i = 0; i < sizeof(exe) / sizeof(exe[0]); i++) {
+    if (stat(exe[i], &st) == 0) {
+      stringstream s;
+      s << st.st_dev << ":" << st.st_ino << ":" << st.st_size << ":"
+        << st.st_mtime;
+      return s.str();
+    }
+  }
+  return "";
+}
+#endif
+
+BuildCache::BuildCache() : _maxSize(DEFAULT_SIZE * 1024LL * 1024LL) {
+#ifndef WIN32
+  const char *env;
+  if ((env = getenv("GPT_CACHE_DIR")) && strlen(env)) {
+    _dir = env;
+  } else if ((env = getenv("XDG_CACHE_HOME")) && strlen(env)) {
+    _dir = string(env) + "/" + PACKAGE;
+  } else if ((env = getenv("HOME")) && strlen(env)) {
+    _dir = string(env) + "/.cache/" + PACKAGE;
+  }
+
+  if ((env = getenv("GPT_CACHE_SIZE")) && strlen(env)) {
+    _maxSize = atoll(env) * 1024LL * 1024LL;
+  }
+  // sem como identificar o executavel, uma entrada antiga poderia ser
+  // confundida com a saida deste gpt
+  _build = buildId();
+  if ((_maxSize <= 0) || _build.empty()) {
+    _dir.clear();
+  }
+#endif
+}
+
+string BuildCache::key(const list<string> &ifnames, int target) const {
+  if (!enabled()) {
+    return "";
+  }
+
+  stringstream s;
+  s << "build" << '\0' << _build << '\0' << target << '\0';
+  for (list<string>::const_iterator it = ifnames.begin(); it != ifnames.end();
+       ++it) {
+    string data;
+    if (!readFile(*it, data)) {
+      return "";
+    }
+    s << *it << '\0' << data.length() << '\0' << data;
+  }
+
+  stringstream k;
+  k << hex << setw(16) << setfill('0') << LibraryCache::hash(s.str());
+  return k.str();
+}
+
+bool BuildCache::get(const string &key, string &name, string &data) const {
+  if (key.empty()) {
+    return false;
+  }
+
+  string entry = _dir + "/" + key;
+  string contents;
+  if (!readFile(entry, contents)) {
+    return false;
+  }
+
+  // primeira linha: nome do algoritmo
+  string::size_type nl = contents.find('\n');
+  if (nl == string::npos) {
+    return false;
+  }
+  name = contents.substr(0, nl);
+  data = contents.substr(nl + 1);
+
+#ifndef WIN32
+  utime(entry.c_str(), 0); // usada agora (ver evict)
+#endif
+  return true;
+}
+
+void BuildCache::put(const string &key, const string &name,
+                     const string &ofname) const {
+#ifndef WIN32
+  string data;
+  if (key.empty() || !readFile(ofname, data) || !makeDirs(_dir)) {
+    return;
+  }
+
+  string entry = _dir + "/" + key;
+  stringstream tmp;
+  tmp << entry << ".tmp." << getpid() << "." << this_thread::get_id();
+  if (!write(tmp.str(), name + "\n" + data, false) ||
+      (rename(tmp.str().c_str(), entry.c_str()) != 0)) {
+    unlink(tmp.str().c_str());
+    return;
+  }
+
+  evict();
+#endif
+}
+
+bool BuildCache::write(const string &ofname, const string &data, bool exec) {
+  ofstream fo(ofname.c_str(), ios_base::out | ios_base::binary);
+  if (!fo) {
+    return false;
+  }
+  fo << data;
+  fo.close();
+  if (!fo) {
+    return false;
+  }
+#ifndef WIN32
+  if (exec) {
+    chmod(ofname.c_str(), 0755);
+  }
+#endif
+  return true;
+}
+
+void BuildCache::evict() const {
+#ifndef WIN32
+  DIR *dir = opendir(_dir.c_str());
+  if (!dir) {
+    return;
+  }
+
+  // (ultimo uso, tamanho, arquivo) das entradas
+  vector<pair<time_t, pair<long long, string>>> entries;
+  long long total = 0;
+  struct dirent *e;
+  while ((e = readdir(dir))) {
+    string file = _dir + "/" + e->d_name;
+    struct stat st;
+    if ((strlen(e->d_name) != 16) || (stat(file.c_str(), &st) != 0) ||
+        !S_ISREG(st.st_mode)) {
+      continue;
+    }
+    entries.push_back(make_pair(st.st_mtime, make_pair(st.st_size, file)));
+    total += st.st_size;
+  }
+  closedir(dir);
+
+  sort(entries.begin(), entries.end());
+  for (unsigned i = 0; (i < entries.size()) && (total > _maxSize); i++) {
+    unlink(entries[i].second.second.c_str());
+    total -= entries[i].second.first;
+  }
+#endif
+}
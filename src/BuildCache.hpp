@@ -0,0 +1,70 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef BUILDCACHE_HPP
+#define BUILDCACHE_HPP
+
+#include <list>
+#include <string>
+
+using namespace std;
+
+// cache em disco dos arquivos gerados por -o, -t e -s (e --separate). A chave
+// e' um hash do nome e do conteudo dos arquivos do algoritmo, da versao do
+// gpt, do executavel em uso (dispositivo, inode, tamanho e data) e do tipo
+// de saida; cada entrada guarda o nome do algoritmo e o arquivo gerado. Quando o tamanho total passa do limite, as entradas usadas ha mais
+// tempo sao removidas.
+//
+// Diretorio: $GPT_CACHE_DIR, $XDG_CACHE_HOME/gpt ou ~/.cache/gpt. Limite:
+// $GPT_CACHE_SIZE (MB), padrao DEFAULT_SIZE. Desabilitado em WIN32 e onde o
+// executavel nao pode ser identificado (sem /proc).
+// Os metodos podem ser chamados de varias threads.
+class BuildCache {
+public:
+  static const int DEFAULT_SIZE = 64; // MB
+
+  BuildCache();
+
+  void disable() { _dir.clear(); }
+  bool enabled() const { return !_dir.empty(); }
+
+  // chave de ifnames com a saida target (GPT::TARGET_*); vazia se algum
+  // arquivo nao puder ser lido ou o cache estiver desabilitado
+  string key(const list<string> &ifnames, int target) const;
+
+  // entrada de key: nome do algoritmo e conteudo gerado
+  bool get(const string &key, string &name, string &data) const;
+
+  // guarda ofname (ja gerado) como entrada de key
+  void put(const string &key, const string &name, const string &ofname) const;
+
+  // grava data em ofname (executavel se exec)
+  static bool write(const string &ofname, const string &data, bool exec);
+
+private:
+  void evict() const;
+
+  string _dir;
+  string _build; // identificacao do executavel (ver buildId)
+  long long _maxSize; // bytes
+};
+
+#endif
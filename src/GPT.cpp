@@ -19,44 +19,58 @@
  ***************************************************************************/
 
 #include "GPT.hpp"
+#include "BatchRunner.hpp"
+#include "BuildCache.hpp"
 #include "config.h"
 
 #ifdef WIN32
 #include <io.h> //unlink()
 #endif
 
+#include "GPTDisplay.hpp"
 #include "InterpreterWalker.hpp"
 #include "Portugol2CWalker.hpp"
-#include "PortugolLexer.hpp"
-#include "PortugolParser.hpp"
-#include "SemanticWalker.hpp"
+#include "VirtualMachine.hpp"
 #include "X86Walker.hpp"
 #include <antlr/AST.hpp>
-#include <antlr/TokenStreamSelector.hpp>
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <unistd.h>
-
-GPT *GPT::_self = 0;
+#include <vector>
 
 GPT::GPT()
-    : /*_usePipe(false),*/ _printParseTree(false), _useOutputFile(false) {}
+    : /*_usePipe(false),*/ _showTips(false), _printParseTree(false),
+      _useTreeWalker(false), _showStats(false), _useOutputFile(false) {}
 
 GPT::~GPT() {}
 
-GPT *GPT::self() {
-  if (!GPT::_self) {
-    GPT::_self = new GPT();
-  }
-  return GPT::_self;
+void GPT::reportDicas(bool value) {
+  _showTips = value;
+  _program.showTips(value);
 }
 
-void GPT::reportDicas(bool value) { GPTDisplay::self()->showTips(value); }
-
 void GPT::printParseTree(bool value) { _printParseTree = value; }
 
+void GPT::useTreeWalker(bool value) { _useTreeWalker = value; }
+
+void GPT::setLimits(const ExecutionLimits &limits) { _limits = limits; }
+
+void GPT::setProfileFile(const string &file) { _profileFile = file; }
+
+void GPT::showStats(bool value) { _showStats = value; }
+
+void GPT::useCache(bool value) {
+  if (!value) {
+    _cache.disable();
+  }
+}
+
 // void GPT::usePipe(bool value)
 // {
 //   _usePipe = value;
@@ -91,10 +105,34 @@ void GPT::showHelp() {
        "   -t <arquivo>  salva o código em linguagem C como <arquivo>\n"
        "   -s <arquivo>  salva o código em linguagem Assembly como <arquivo>\n"
        "   -i            interpreta o algoritmo\n"
-       "   -d            exibe dicas no relatório de erros\n\n"
+       "   -d            exibe dicas no relatório de erros\n"
+       "   --tree-walker interpreta percorrendo a árvore sintática (modo "
+       "antigo)\n"
+       "   --max-depth <n> limita a profundidade de chamadas de funções ao "
+       "interpretar\n"
+       "   --max-steps <n> limita o número de comandos executados ao "
+       "interpretar\n"
+       "   --max-memory <MB> limita a memória usada por matrizes ao "
+       "interpretar\n"
+       "   --timeout <s> limita o tempo de execução ao interpretar\n"
+       "   --profile <arquivo> salva o perfil de execução do algoritmo "
+       "interpretado\n"
+       "   --stats       exibe estatísticas da interpretação em JSON (na saída "
+       "de erros)\n"
+       "   --batch <manifesto> interpreta os algoritmos do manifesto com cada "
+       "arquivo de entrada\n"
+       "   --batch-output <arquivo> salva o resultado do modo --batch em "
+       "<arquivo>\n"
+       "   --jobs <n>    número de execuções (ou compilações) simultâneas nos "
+       "modos --batch e --separate\n"
+       "   --separate    com -o, -t ou -s, compila cada arquivo como um "
+       "algoritmo, salvando o resultado no diretório dado\n"
+       "   --precompile <arquivo> salva em <arquivo> a forma pré-compilada de "
+       "um arquivo de funções (como base.gpt)\n"
+       "   --no-cache    não usa o cache de arquivos gerados por -o, -t e -s\n\n"
        "   Maiores informações no manual.\n";
 
-  GPTDisplay::self()->showMessage(s);
+  GPTDisplay::showMessage(s);
 }
 
 void GPT::showVersion() {
@@ -107,60 +145,48 @@ void GPT::showVersion() {
        "Copyright (C) 2003-2009 Thiago Silva <tsilva@sourcecraft.info>\n"
        "Copyright (C) 2026 G-Portugol contributors "
        "<gportugol@googlegroups.com>\n\n";
-  GPTDisplay::self()->showMessage(s);
+  GPTDisplay::showMessage(s);
 }
 
 bool GPT::prologue(const list<string> &ifnames) {
   stringstream s;
-  bool success = false;
 
   //   if(_usePipe) { //shell pipe (stdin)
   //     if(cin.rdbuf()->in_avail() == 0) {
   //       s << PACKAGE << ": não existem dados na entrada padrão" << endl;
-  //       GPTDisplay::self()->showError(s);
-  //       goto bail;
-  //     }
-  //
-  //     if(!parse(cin)) {
-  //       goto bail;
+  //       GPTDisplay::showError(s);
+  //       return false;
   //     }
-  //   } else {
-  list<pair<string, istream *>> istream_list;
-  for (list<string>::const_iterator it = ifnames.begin(); it != ifnames.end();
-       ++it) {
-    ifstream *fi = new ifstream((*it).c_str());
-    // fi.open((*it).c_str(), ios_base::in);
-    if (!*fi) {
-      s << PACKAGE << ": não foi possível abrir o arquivo: \"" << (*it) << "\""
-        << endl;
-      GPTDisplay::self()->showError(s);
-      goto bail;
-    }
-    istream_list.push_back(pair<string, istream *>(*it, fi));
-  }
+  //   }
 
-  if (!parse(istream_list)) {
-    goto bail;
+  _program.printParseTree(_printParseTree);
+  if (!_program.parseFiles(ifnames)) {
+    s << _program.errors();
+    GPTDisplay::showError(s);
+    return false;
   }
 
-  success = true;
-
-bail:
-  return success;
+  if (_outputfile.empty()) {
+    _outputfile = _program.name();
+  }
+  return true;
 }
 
 bool GPT::compile(const list<string> &ifnames, bool genBinary) {
-  bool success = false;
-  stringstream s;
+  return build(ifnames, genBinary ? TARGET_BINARY : TARGET_ASM);
+}
 
-  if (!prologue(ifnames)) {
-    return false;
-  }
+bool GPT::translate2C(const list<string> &ifnames) {
+  return build(ifnames, TARGET_C);
+}
 
+string GPT::outputFile(int target) {
   string ofname = _outputfile;
   if (!_useOutputFile) {
-    if (!genBinary) {
+    if (target == TARGET_ASM) {
       ofname += ".asm";
+    } else if (target == TARGET_C) {
+      ofname += ".c";
     }
 #ifdef WIN32
     else {
@@ -168,46 +194,101 @@ bool GPT::compile(const list<string> &ifnames, bool genBinary) {
     }
 #endif
   }
+  return ofname;
+}
+
+bool GPT::build(const list<string> &ifnames, int target) {
+  stringstream s;
+
+  // -D precisa da analise
+  string key;
+  if (!_printParseTree) {
+    key = _cache.key(ifnames, target);
+  }
+
+  string name;
+  string data;
+  if (_cache.get(key, name, data)) {
+    if (_outputfile.empty()) {
+      _outputfile = name;
+    }
+    string ofname = outputFile(target);
+    if (!BuildCache::write(ofname, data, target == TARGET_BINARY)) {
+      s << PACKAGE << ": não foi possível abrir o arquivo: \"" << ofname
+        << "\"" << endl;
+      GPTDisplay::showError(s);
+      return false;
+    }
+    return true;
+  }
+
+  if (!prologue(ifnames)) {
+    return false;
+  }
+
+  string ofname = outputFile(target);
+  if (!generate(_program, target, ofname, s)) {
+    GPTDisplay::showError(s);
+    return false;
+  }
+  _cache.put(key, _program.name(), ofname);
+  return true;
+}
+
+bool GPT::generate(CompiledProgram &program, int target, const string &ofname,
+                   stringstream &s) {
+  bool success = false;
+  string ftmpname;
 
   try {
-    X86Walker x86(_stable);
-    string asmsrc = x86.algoritmo(_astree);
+    string src;
+    {
+      lock_guard<mutex> lock(CompiledProgram::treeParserMutex());
+      if (target == TARGET_C) {
+        Portugol2CWalker pt2c(program.symbols());
+        src = pt2c.algoritmo(program.ast());
+      } else {
+        X86Walker x86(program.symbols());
+        src = x86.algoritmo(program.ast());
+      }
+    }
 
-    string ftmpname = createTmpFile();
     ofstream fo;
 
-    if (!genBinary) { // salva assembly code
+    if (target != TARGET_BINARY) { // salva codigo C ou assembly
       fo.open(ofname.c_str(), ios_base::out);
       if (!fo) {
         s << PACKAGE << ": não foi possível abrir o arquivo: \"" << ofname
           << "\"" << endl;
-        GPTDisplay::self()->showError(s);
         goto bail;
       }
-      fo << asmsrc;
+      fo << src;
       fo.close();
     } else { // compile
+      ftmpname = createTmpFile();
       fo.open(ftmpname.c_str(), ios_base::out);
       if (!fo) {
         s << PACKAGE << ": erro ao processar arquivo temporário" << endl;
-        GPTDisplay::self()->showError(s);
         goto bail;
       }
-      fo << asmsrc;
+      fo << src;
       fo.close();
 
       stringstream cmd;
       cmd << "nasm -O1 -fbin -o \"" << ofname << "\" " << ftmpname;
 
-      if (system(cmd.str().c_str()) == -1) {
+      int status = system(cmd.str().c_str());
+      if (status == -1) {
         s << PACKAGE << ": não foi possível invocar o nasm." << endl;
-        GPTDisplay::self()->showError(s);
+        goto bail;
+      } else if (status != 0) {
+        s << PACKAGE << ": erro ao montar o código gerado (nasm)." << endl;
         goto bail;
       }
 
 #ifndef WIN32
       cmd.str("");
-      cmd << "chmod +x " << ofname;
+      cmd << "chmod +x \"" << ofname << "\"";
       system(cmd.str().c_str());
 #endif
     }
@@ -221,146 +302,237 @@ bool GPT::compile(const list<string> &ifnames, bool genBinary) {
     return success;
   } catch (SymbolTableException &e) {
     s << PACKAGE << ": erro interno: " << e.getMessage() << endl;
-    GPTDisplay::self()->showError(s);
     return false;
   }
 }
 
-bool GPT::translate2C(const list<string> &ifnames) {
-  bool success = false;
-  stringstream s;
-
-  if (!prologue(ifnames)) {
-    return false;
+// nome do arquivo gerado a partir de "file" no modo compileEach:
+// dir/prog.gpt -> outdir/prog[.asm|.c]
+static string outputName(const string &outdir, const string &file,
+                         int target) {
+  string name = file;
+  string::size_type p = name.find_last_of("/\\");
+  if (p != string::npos) {
+    name = name.substr(p + 1);
+  }
+  p = name.rfind('.');
+  if ((p != string::npos) && (p > 0)) {
+    name = name.substr(0, p);
   }
 
-  string ofname = _outputfile;
-  if (!_useOutputFile) {
-    ofname += ".c";
+  if (target == GPT::TARGET_ASM) {
+    name += ".asm";
+  } else if (target == GPT::TARGET_C) {
+    name += ".c";
   }
+#ifdef WIN32
+  else {
+    name += ".exe";
+  }
+#endif
 
-  try {
-    Portugol2CWalker pt2c(_stable);
-    string c_src = pt2c.algoritmo(_astree);
+  if (outdir.empty()) {
+    return name;
+  }
+  return outdir + "/" + name;
+}
 
-    ofstream fo;
-    fo.open(ofname.c_str(), ios_base::out);
-    if (!fo) {
-      s << PACKAGE << ": não foi possível abrir o arquivo: \"" << ofname << "\""
+bool GPT::compileEach(const list<string> &ifnames,
+                      const list<string> &includes, int target,
+                      const string &outdir, int jobs) {
+  vector<string> files(ifnames.begin(), ifnames.end());
+  vector<string> errors(files.size());
+  vector<char> ok(files.size(), 0);
+  atomic<unsigned> next(0);
+
+  // arquivos com o mesmo nome em diretorios diferentes (a/x.gpt, b/x.gpt)
+  // gerariam o mesmo arquivo de saida, gravado por duas threads
+  vector<string> ofnames(files.size());
+  map<string, unsigned> used;
+  for (unsigned i = 0; i < files.size(); i++) {
+    ofnames[i] = outputName(outdir, files[i], target);
+    map<string, unsigned>::iterator it = used.find(ofnames[i]);
+    if (it != used.end()) {
+      stringstream s;
+      s << PACKAGE << ": os arquivos \"" << files[it->second] << "\" e \""
+        << files[i] << "\" gerariam o mesmo arquivo: \"" << ofnames[i] << "\""
         << endl;
-      GPTDisplay::self()->showError(s);
-      goto bail;
+      GPTDisplay::showError(s);
+      return false;
     }
-    fo << c_src;
-    fo.close();
+    used[ofnames[i]] = i;
+  }
 
-    success = true;
+  // cada thread pega o proximo arquivo ainda nao compilado. Alem de next e
+  // das posicoes i, as compilacoes compartilham _cache (cujos metodos podem
+  // ser chamados de varias threads) e o estado estatico do ANTLR: analise
+  // semantica e geracao de codigo usam tree parsers e rodam uma de cada vez
+  // (CompiledProgram::treeParserMutex). Analise sintatica, otimizacao,
+  // gravacao e nasm rodam em paralelo
+  auto worker = [&]() {
+    unsigned i;
+    while ((i = next++) < files.size()) {
+      list<string> sources(includes);
+      sources.push_front(files[i]);
+
+      stringstream s;
+      const string &ofname = ofnames[i];
+      string key = _cache.key(sources, target);
+      string name;
+      string data;
+      if (_cache.get(key, name, data)) {
+        ok[i] = BuildCache::write(ofname, data, target == TARGET_BINARY);
+        if (!ok[i]) {
+          s << PACKAGE << ": não foi possível abrir o arquivo: \"" << ofname
+            << "\"" << endl;
+        }
+        errors[i] = s.str();
+        continue;
+      }
 
-  bail:
-    return success;
-  } catch (SymbolTableException &e) {
-    s << PACKAGE << ": erro interno: " << e.getMessage() << endl;
-    GPTDisplay::self()->showError(s);
-    return false;
+      CompiledProgram program;
+      program.showTips(_showTips);
+      program.parseJobs(1); // os arquivos ja sao compilados em paralelo
+      if (!program.parseFiles(sources)) {
+        s << program.errors();
+      } else if ((ok[i] = generate(program, target, ofname, s))) {
+        _cache.put(key, program.name(), ofname);
+      }
+      errors[i] = s.str();
+    }
+  };
+
+  if (jobs > (int)files.size()) {
+    jobs = files.size();
+  }
+  vector<thread> threads;
+  for (int t = 1; t < jobs; t++) {
+    threads.push_back(thread(worker));
+  }
+  worker();
+  for (unsigned t = 0; t < threads.size(); t++) {
+    threads[t].join();
   }
-}
 
-int GPT::interpret(const list<string> &ifnames, const string &host, int port) {
-  if (!prologue(ifnames)) {
-    return 0;
+  // erros na ordem dos arquivos, nao na ordem em que terminaram
+  bool success = true;
+  for (unsigned i = 0; i < files.size(); i++) {
+    if (!errors[i].empty()) {
+      GPTDisplay::showError(errors[i]);
+    }
+    success = success && ok[i];
   }
+  return success;
+}
 
-  InterpreterWalker interpreter(_stable, host, port);
-  int r = interpreter.algoritmo(_astree);
+bool GPT::precompile(const list<string> &ifnames, const string &ofname) {
+  stringstream s;
+
+  if (ifnames.size() != 1) {
+    s << PACKAGE << ": a opção --precompile requer um único arquivo." << endl;
+    GPTDisplay::showError(s);
+    return false;
+  }
 
-  return r;
+  string errors;
+  if (!CompiledProgram::precompile(ifnames.front(), ofname, errors)) {
+    s << errors;
+    GPTDisplay::showError(s);
+    return false;
+  }
+  return true;
 }
 
-bool GPT::parse(list<pair<string, istream *>> &istream_list) {
+int GPT::interpret(const list<string> &ifnames, const string &host, int port) {
   stringstream s;
 
+  if (!prologue(ifnames)) {
+    return 0;
+  }
+
   try {
-    TokenStreamSelector *selector = new TokenStreamSelector;
-
-    // codigo desgracado, mas faz o que deve
-    // 1: controle de multiplos tokenStreams
-    // 2: utilizar o filename adequado para error reporting
-
-    PortugolLexer *lexer;
-    PortugolLexer *prev = 0;
-    PortugolLexer *fst = 0;
-    string firstFile;
-    int c = 0;
-    for (list<pair<string, istream *>>::reverse_iterator it =
-             istream_list.rbegin();
-         it != istream_list.rend(); ++it, ++c) {
-      lexer = new PortugolLexer(*((*it).second), selector);
-
-      selector->addInputStream(lexer, (*it).first);
-      selector->select(lexer);
-      selector->push((*it).first);
-      if (!firstFile.empty()) {
-        lexer->setNextFilename(firstFile);
+    if (_useTreeWalker) {
+      InterpreterWalker interpreter(_program.symbols(), host, port);
+      interpreter.setLimits(_limits);
+      if (!_profileFile.empty() && !interpreter.setProfile(_profileFile)) {
+        s << PACKAGE << ": não foi possível abrir o arquivo: \"" << _profileFile
+          << "\"" << endl;
+        GPTDisplay::showError(s);
+        return EXIT_FAILURE;
       }
-
-      prev = lexer;
-      GPTDisplay::self()->addFileName((*it).first);
-
-      firstFile = (*it).first;
-      fst = lexer;
+      if (_showStats) {
+        interpreter.enableStats(_program.phases());
+      }
+      return interpreter.algoritmo(_program.ast());
     }
 
-    selector->select(fst);
-
-    PortugolParser parser(*selector);
-
-    GPTDisplay::self()->setCurrentFile(firstFile);
-
-    ASTFactory ast_factory(PortugolAST::TYPE_NAME, &PortugolAST::factory);
-    parser.initializeASTFactory(ast_factory);
-    parser.setASTFactory(&ast_factory);
-
-    parser.algoritmo();
-    if (_outputfile.empty()) {
-      _outputfile = parser.nomeAlgoritmo();
+    Bytecode &program = _program.bytecode();
+    VirtualMachine vm(_program.symbols(), program, host, port);
+    vm.setLimits(_limits);
+    if (!_profileFile.empty() && !vm.setProfile(_profileFile)) {
+      s << PACKAGE << ": não foi possível abrir o arquivo: \"" << _profileFile
+        << "\"" << endl;
+      GPTDisplay::showError(s);
+      return EXIT_FAILURE;
     }
-
-    if (GPTDisplay::self()->hasError()) {
-      GPTDisplay::self()->showErrors();
-      return false;
+    if (_showStats) {
+      vm.enableStats(_program.phases());
     }
+    return vm.run();
+  } catch (ExecutionError &e) {
+    GPTDisplay::showError(e.message);
+    return e.exitCode;
+  }
+}
 
-    _astree = parser.getPortugolAST();
+int GPT::batch(const string &manifest, const list<string> &ifnames,
+               const string &resultFile, int jobs) {
+  BatchRunner runner;
+  if (!runner.readManifest(manifest)) {
+    return EXIT_FAILURE;
+  }
 
-    if (!_astree) {
-      s << PACKAGE << ": erro interno: no parse tree" << endl;
-      GPTDisplay::self()->showError(s);
-      return false;
+  // cada algoritmo e' analisado e compilado uma unica vez. Os processos
+  // filhos herdam o resultado.
+  vector<CompiledProgram *> programs;
+  for (unsigned i = 0; i < runner.programs.size(); i++) {
+    BatchRunner::Program &p = runner.programs[i];
+    list<string> files = p.files;
+    files.insert(files.end(), ifnames.begin(), ifnames.end());
+
+    CompiledProgram *program = new CompiledProgram;
+    program->showTips(_showTips);
+    p.ok = program->parseFiles(files);
+    p.errors = program->errors();
+    if (p.ok && !_useTreeWalker) {
+      program->bytecode();
     }
+    programs.push_back(program);
+  }
 
-    if (_printParseTree) {
-      std::cerr << _astree->toStringList() << std::endl << std::endl;
+  runner.run(jobs, [&](int i, ostream &stats) -> int {
+    vector<pair<string, double>> phases;
+    try {
+      if (_useTreeWalker) {
+        InterpreterWalker interpreter(programs[i]->symbols(), "", 0);
+        interpreter.setLimits(_limits);
+        interpreter.enableStats(phases, stats);
+        return interpreter.algoritmo(programs[i]->ast());
+      }
+      VirtualMachine vm(programs[i]->symbols(), programs[i]->bytecode(), "",
+                        0);
+      vm.setLimits(_limits);
+      vm.enableStats(phases, stats);
+      return vm.run();
+    } catch (ExecutionError &e) {
+      GPTDisplay::showError(e.message);
+      return e.exitCode;
     }
+  });
 
-    SemanticWalker semantic(_stable);
-    semantic.algoritmo(_astree);
-
-    if (GPTDisplay::self()->hasError()) {
-      GPTDisplay::self()->showErrors();
-      return false;
-    }
-    return true;
-  } catch (ANTLRException &e) {
-    s << PACKAGE << ": erro interno: " << e.toString() << endl;
-    GPTDisplay::self()->showError(s);
-    return false;
-  } catch (exception &e) {
-    s << PACKAGE << ": erro interno: " << e.what() << endl;
-    GPTDisplay::self()->showError(s);
-    return false;
+  for (unsigned i = 0; i < programs.size(); i++) {
+    delete programs[i];
   }
 
-  s << "GPT::parse: bug, nao deveria executar essa linha!" << endl;
-  GPTDisplay::self()->showError(s);
-  return false;
+  return runner.write(resultFile) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -22,22 +22,31 @@
 #define GPT_HPP
 
 #include <list>
+#include <sstream>
 #include <string>
 
-#include "PortugolAST.hpp"
-#include "SymbolTable.hpp"
+#include "BuildCache.hpp"
+#include "CompiledProgram.hpp"
+#include "ExecutionLimits.hpp"
 
 using namespace std;
 using namespace antlr;
 
 class GPT {
 public:
-  ~GPT();
+  // codigo gerado por compileEach
+  enum { TARGET_BINARY, TARGET_ASM, TARGET_C };
 
-  static GPT *self();
+  GPT();
+  ~GPT();
 
   void reportDicas(bool value);
   void printParseTree(bool value);
+  void useTreeWalker(bool value);
+  void setLimits(const ExecutionLimits &limits);
+  void setProfileFile(const string &file);
+  void showStats(bool value);
+  void useCache(bool value); // BuildCache em -o, -t e -s
   //   void usePipe(bool value);
   void setOutputFile(string str);
 
@@ -47,25 +56,45 @@ public:
   bool compile(const list<string> &ifnames, bool genBinary = true);
   bool translate2C(const list<string> &ifnames);
   int interpret(const list<string> &ifnames, const string &host, int port);
+  int batch(const string &manifest, const list<string> &ifnames,
+            const string &resultFile, int jobs);
 
-private:
-  GPT();
+  // cada arquivo de ifnames e' um algoritmo (junto com includes), compilado
+  // em paralelo por ate' jobs threads. O resultado fica em outdir, com o nome
+  // do arquivo de entrada
+  bool compileEach(const list<string> &ifnames, const list<string> &includes,
+                   int target, const string &outdir, int jobs);
 
-  static GPT *_self;
+  // forma pre-compilada (LibraryCache) de um arquivo de funcoes
+  bool precompile(const list<string> &ifnames, const string &ofname);
 
+private:
   string createTmpFile();
 
-  bool parse(list<pair<string, istream *>> &);
-
   bool prologue(const list<string> &ifname);
 
+  // compile e translate2C, consultando o cache
+  bool build(const list<string> &ifnames, int target);
+
+  // -o/-t/-s ou o nome do algoritmo, com a extensao de target
+  string outputFile(int target);
+
+  // gera o codigo (target) de um algoritmo ja analisado. Erros vao para s
+  bool generate(CompiledProgram &program, int target, const string &ofname,
+                stringstream &s);
+
   //   bool _usePipe;
+  bool _showTips;
   bool _printParseTree;
+  bool _useTreeWalker;
+  ExecutionLimits _limits;
+  string _profileFile;
+  bool _showStats;
   bool _useOutputFile;
   string _outputfile;
 
-  RefPortugolAST _astree;
-  SymbolTable _stable;
+  CompiledProgram _program;
+  BuildCache _cache;
 };
 
 #endif
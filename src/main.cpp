@@ -23,11 +23,13 @@
 #include "GPT.hpp"
 #include "GPTDisplay.hpp"
 
+#include <getopt.h>
 #include <list>
 #include <sstream>
 #include <stdio.h>
 #include <string.h>
 #include <string>
+#include <thread>
 #include <unistd.h>
 
 #define DEFAULT_PORT "7680"
@@ -36,7 +38,11 @@ using namespace std;
 
 enum {
   FLAG_DICA = 0x1,
-  FLAG_PRINT_AST = 0x2
+  FLAG_PRINT_AST = 0x2,
+  FLAG_TREE_WALKER = 0x4,
+  FLAG_STATS = 0x8,
+  FLAG_SEPARATE = 0x10,
+  FLAG_NO_CACHE = 0x20
   // FLAG_PIPE  = 0x1,
 };
 
@@ -47,9 +53,44 @@ enum {
   CMD_GPT_2_C,
   CMD_GPT_2_ASM,
   CMD_INTERPRET,
+  CMD_BATCH,
+  CMD_PRECOMPILE,
   CMD_INVALID
 };
 
+// opcoes longas (sem equivalente curto)
+enum {
+  OPT_TREE_WALKER = 256,
+  OPT_MAX_DEPTH,
+  OPT_MAX_STEPS,
+  OPT_MAX_MEMORY,
+  OPT_TIMEOUT,
+  OPT_PROFILE,
+  OPT_STATS,
+  OPT_BATCH,
+  OPT_BATCH_OUTPUT,
+  OPT_JOBS,
+  OPT_SEPARATE,
+  OPT_PRECOMPILE,
+  OPT_NO_CACHE
+};
+
+static struct option long_options[] = {
+    {"tree-walker", no_argument, 0, OPT_TREE_WALKER},
+    {"max-depth", required_argument, 0, OPT_MAX_DEPTH},
+    {"max-steps", required_argument, 0, OPT_MAX_STEPS},
+    {"max-memory", required_argument, 0, OPT_MAX_MEMORY},
+    {"timeout", required_argument, 0, OPT_TIMEOUT},
+    {"profile", required_argument, 0, OPT_PROFILE},
+    {"stats", no_argument, 0, OPT_STATS},
+    {"batch", required_argument, 0, OPT_BATCH},
+    {"batch-output", required_argument, 0, OPT_BATCH_OUTPUT},
+    {"jobs", required_argument, 0, OPT_JOBS},
+    {"separate", no_argument, 0, OPT_SEPARATE},
+    {"precompile", required_argument, 0, OPT_PRECOMPILE},
+    {"no-cache", no_argument, 0, OPT_NO_CACHE},
+    {0, 0, 0, 0}};
+
 //----- globals ------
 
 int _flags = 0;
@@ -57,6 +98,15 @@ list<string> _ifilenames;
 
 string _host;
 string _port = DEFAULT_PORT;
+string _maxDepth;
+string _maxSteps;
+string _maxMemory;
+string _timeout;
+string _profile;
+string _batch;
+string _batchOutput;
+string _jobs;
+string _precompiled;
 
 string _csource;
 string _asmsource;
@@ -79,13 +129,18 @@ static int init(int argc, char **argv) {
   /*
     Opcoes:  o: <output>,  t: <output>,  s: <output>, H: <host>,  P: <port>,
     h[help] v[ersion],  i[nterpret],  p[ipe],  d[ica]
+    --tree-walker, --max-depth, --max-steps, --max-memory, --timeout,
+    --profile, --stats, --batch, --batch-output, --jobs, --separate,
+    --precompile, --no-cache
   */
 
 #ifndef DEBUG
-  while ((c = getopt(argc, argv, "o:t:s:H:P:idvh")) != -1) {
+  while ((c = getopt_long(argc, argv, "o:t:s:H:P:idvh", long_options, 0)) !=
+         -1) {
     switch (c) {
 #else
-  while ((c = getopt(argc, argv, "o:t:s:H:P:idvhD")) != -1) {
+  while ((c = getopt_long(argc, argv, "o:t:s:H:P:idvhD", long_options, 0)) !=
+         -1) {
     switch (c) {
     case 'D':
       _flags |= FLAG_PRINT_AST;
@@ -128,6 +183,49 @@ static int init(int argc, char **argv) {
     case 'd':
       _flags |= FLAG_DICA;
       break;
+    case OPT_TREE_WALKER:
+      _flags |= FLAG_TREE_WALKER;
+      break;
+    case OPT_MAX_DEPTH:
+      _maxDepth = optarg;
+      break;
+    case OPT_MAX_STEPS:
+      _maxSteps = optarg;
+      break;
+    case OPT_MAX_MEMORY:
+      _maxMemory = optarg;
+      break;
+    case OPT_TIMEOUT:
+      _timeout = optarg;
+      break;
+    case OPT_PROFILE:
+      _profile = optarg;
+      break;
+    case OPT_STATS:
+      _flags |= FLAG_STATS;
+      break;
+    case OPT_BATCH:
+      count_cmds++;
+      cmd = CMD_BATCH;
+      _batch = optarg;
+      break;
+    case OPT_BATCH_OUTPUT:
+      _batchOutput = optarg;
+      break;
+    case OPT_JOBS:
+      _jobs = optarg;
+      break;
+    case OPT_SEPARATE:
+      _flags |= FLAG_SEPARATE;
+      break;
+    case OPT_NO_CACHE:
+      _flags |= FLAG_NO_CACHE;
+      break;
+    case OPT_PRECOMPILE:
+      count_cmds++;
+      cmd = CMD_PRECOMPILE;
+      _precompiled = optarg;
+      break;
       //       case 'p':
       //         _flags |= FLAG_PIPE;
       //         break;
@@ -140,21 +238,26 @@ static int init(int argc, char **argv) {
       if ((optopt == 'o') || (optopt == 't') || (optopt == 's')) {
         s << PACKAGE << ": faltando argumento para opção -" << (char)optopt
           << endl;
+      } else if (optopt >= OPT_TREE_WALKER) {
+        s << PACKAGE << ": faltando argumento para opção " << argv[optind - 1]
+          << endl;
+      } else if (optopt == 0) {
+        s << PACKAGE << ": opção inválida: " << argv[optind - 1] << endl;
       } else {
         s << PACKAGE << ": opção inválida: -" << char(optopt) << endl;
       }
-      GPTDisplay::self()->showError(s);
+      GPTDisplay::showError(s);
       goto bail;
     default:
       s << PACKAGE << ": erro interno." << endl;
-      GPTDisplay::self()->showError(s);
+      GPTDisplay::showError(s);
       goto bail;
     }
   }
 
   if (count_cmds > 1) {
     s << PACKAGE << ": mais de um comando selecionado." << endl;
-    GPTDisplay::self()->showError(s);
+    GPTDisplay::showError(s);
     goto bail;
   }
 
@@ -164,29 +267,68 @@ static int init(int argc, char **argv) {
     _ifilenames.push_back(argv[c++]);
   }
 
-  if (_ifilenames.size() == 0) {
+  // no modo --batch os algoritmos estao no manifesto
+  if ((_ifilenames.size() == 0) && (CMD_BATCH != cmd)) {
     s << PACKAGE << ": nenhum arquivo especificado." << endl;
-    GPTDisplay::self()->showError(s);
+    GPTDisplay::showError(s);
     goto bail;
   }
   //   }
 
-  if (CMD_INTERPRET == cmd) {
+  if ((CMD_INTERPRET == cmd) || (CMD_BATCH == cmd)) {
     if ((_port != DEFAULT_PORT) && (atoi(_port.c_str()) == 0)) {
       s << PACKAGE << ": porta de conexão inválida: \"" << _port << "\""
         << endl;
-      GPTDisplay::self()->showError(s);
+      GPTDisplay::showError(s);
+      goto bail;
+    }
+    if (!_maxDepth.empty() && (atoi(_maxDepth.c_str()) <= 0)) {
+      s << PACKAGE << ": profundidade máxima inválida: \"" << _maxDepth
+        << "\"" << endl;
+      GPTDisplay::showError(s);
+      goto bail;
+    }
+    if (!_maxSteps.empty() && (atoll(_maxSteps.c_str()) <= 0)) {
+      s << PACKAGE << ": número máximo de passos inválido: \"" << _maxSteps
+        << "\"" << endl;
+      GPTDisplay::showError(s);
+      goto bail;
+    }
+    if (!_maxMemory.empty() && (atoi(_maxMemory.c_str()) <= 0)) {
+      s << PACKAGE << ": limite de memória inválido: \"" << _maxMemory
+        << "\"" << endl;
+      GPTDisplay::showError(s);
+      goto bail;
+    }
+    if (!_timeout.empty() && (atoi(_timeout.c_str()) <= 0)) {
+      s << PACKAGE << ": tempo limite inválido: \"" << _timeout << "\""
+        << endl;
+      GPTDisplay::showError(s);
       goto bail;
     }
   }
 
+  if ((_flags & FLAG_SEPARATE) && (CMD_COMPILE != cmd) &&
+      (CMD_GPT_2_C != cmd) && (CMD_GPT_2_ASM != cmd)) {
+    s << PACKAGE << ": a opção --separate requer -o, -t ou -s." << endl;
+    GPTDisplay::showError(s);
+    goto bail;
+  }
+
+  if (!_jobs.empty() && (atoi(_jobs.c_str()) <= 0)) {
+    s << PACKAGE << ": número de execuções simultâneas inválido: \"" << _jobs
+      << "\"" << endl;
+    GPTDisplay::showError(s);
+    goto bail;
+  }
+
   return cmd;
 
 bail:
   return CMD_INVALID;
 }
 
-static void appendDefaultFiles() {
+static void appendDefaultFiles(list<string> &files) {
   string inc;
 
   char *env = getenv("GPT_INCLUDE");
@@ -207,13 +349,13 @@ static void appendDefaultFiles() {
 #endif
     filename = inc.substr(b, c);
     if (filename.length()) {
-      _ifilenames.push_back(filename);
+      files.push_back(filename);
     }
     b = c + 1;
   }
   filename = inc.substr(b);
   if (filename.length()) {
-    _ifilenames.push_back(filename);
+    files.push_back(filename);
   }
 }
 
@@ -221,49 +363,113 @@ int main(int argc, char **argv) {
   int cmd = init(argc, argv);
   bool success = false;
   stringstream s;
+  GPT gpt;
 
   if (_flags & FLAG_DICA) {
-    GPT::self()->reportDicas(true);
+    gpt.reportDicas(true);
   } else {
-    GPT::self()->reportDicas(false);
+    gpt.reportDicas(false);
   }
 
   if (_flags & FLAG_PRINT_AST) {
-    GPT::self()->printParseTree(true);
+    gpt.printParseTree(true);
+  }
+
+  if (_flags & FLAG_TREE_WALKER) {
+    gpt.useTreeWalker(true);
+  }
+
+  ExecutionLimits limits;
+  if (!_maxDepth.empty()) {
+    limits.maxDepth = atoi(_maxDepth.c_str());
+  } else if (_flags & FLAG_TREE_WALKER) {
+    limits.maxDepth = ExecutionLimits::DEFAULT_TREE_WALKER_MAX_DEPTH;
+  }
+  if (!_maxSteps.empty()) {
+    limits.maxSteps = atoll(_maxSteps.c_str());
+  }
+  if (!_maxMemory.empty()) {
+    limits.maxMemory = atoi(_maxMemory.c_str()) * 1024LL * 1024LL;
+  }
+  if (!_timeout.empty()) {
+    limits.timeout = atoi(_timeout.c_str());
+  }
+  gpt.setLimits(limits);
+  gpt.setProfileFile(_profile);
+
+  if (_flags & FLAG_STATS) {
+    gpt.showStats(true);
+  }
+
+  if (_flags & FLAG_NO_CACHE) {
+    gpt.useCache(false);
   }
 
   //   if(_flags & FLAG_PIPE) {
-  //     GPT::self()->usePipe(true);
+  //     gpt.usePipe(true);
   //   }
 
-  appendDefaultFiles();
+  int jobs;
+  if (!_jobs.empty()) {
+    jobs = atoi(_jobs.c_str());
+  } else if ((jobs = thread::hardware_concurrency()) <= 0) {
+    jobs = 1;
+  }
+
+  // --separate: cada arquivo e' um algoritmo; os de GPT_INCLUDE entram em
+  // todos eles
+  bool separate = (_flags & FLAG_SEPARATE);
+  list<string> includes;
+  appendDefaultFiles((separate || (CMD_PRECOMPILE == cmd)) ? includes
+                                                           : _ifilenames);
 
   switch (cmd) {
   case CMD_SHOW_VERSION:
-    GPT::self()->showVersion();
+    gpt.showVersion();
     break;
   case CMD_SHOW_HELP:
-    GPT::self()->showHelp();
+    gpt.showHelp();
     break;
   case CMD_COMPILE:
+    if (separate) {
+      success = gpt.compileEach(_ifilenames, includes, GPT::TARGET_BINARY,
+                                _binprogram, jobs);
+      break;
+    }
     if (!_binprogram.empty()) {
-      GPT::self()->setOutputFile(_binprogram);
+      gpt.setOutputFile(_binprogram);
     }
-    success = GPT::self()->compile(_ifilenames);
+    success = gpt.compile(_ifilenames);
     break;
   case CMD_GPT_2_C:
-    GPT::self()->setOutputFile(_csource);
-    success = GPT::self()->translate2C(_ifilenames);
+    if (separate) {
+      success = gpt.compileEach(_ifilenames, includes, GPT::TARGET_C,
+                                _csource, jobs);
+      break;
+    }
+    gpt.setOutputFile(_csource);
+    success = gpt.translate2C(_ifilenames);
     break;
   case CMD_GPT_2_ASM:
-    GPT::self()->setOutputFile(_asmsource);
-    success = GPT::self()->compile(_ifilenames, false);
+    if (separate) {
+      success = gpt.compileEach(_ifilenames, includes, GPT::TARGET_ASM,
+                                _asmsource, jobs);
+      break;
+    }
+    gpt.setOutputFile(_asmsource);
+    success = gpt.compile(_ifilenames, false);
     break;
   case CMD_INTERPRET:
     int result;
-    result = GPT::self()->interpret(_ifilenames, _host, atoi(_port.c_str()));
+    result = gpt.interpret(_ifilenames, _host, atoi(_port.c_str()));
     return result;
     break;
+  case CMD_BATCH:
+    return gpt.batch(_batch, _ifilenames, _batchOutput, jobs);
+    break;
+  case CMD_PRECOMPILE:
+    success = gpt.precompile(_ifilenames, _precompiled);
+    break;
   case CMD_INVALID:
     break;
   }
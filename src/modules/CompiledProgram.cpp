@@ -0,0 +1,349 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "CompiledProgram.hpp"
+#include "config.h"
+
+#include "ASTOptimizer.hpp"
+#include "BytecodeWalker.hpp"
+#include "GPTDisplay.hpp"
+#include "LibraryCache.hpp"
+#include "PortugolLexer.hpp"
+#include "PortugolParser.hpp"
+#include "SemanticWalker.hpp"
+#include "VirtualMachine.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// segundos desde "since", que passa a ser o instante atual
+static double lap(chrono::steady_clock::time_point &since) {
+  chrono::steady_clock::time_point now = chrono::steady_clock::now();
+  double s = chrono::duration<double>(now - since).count();
+  since = now;
+  return s;
+}
+
+CompiledProgram::CompiledProgram()
+    : _printParseTree(false), _parseJobs(0), _program(0) {}
+
+CompiledProgram::~CompiledProgram() { delete _program; }
+
+mutex &CompiledProgram::treeParserMutex() {
+  static mutex m;
+  return m;
+}
+
+bool CompiledProgram::parseFiles(const list<string> &files) {
+  stringstream s;
+  bool success = false;
+
+  list<pair<string, istream *>> istream_list;
+  for (list<string>::const_iterator it = files.begin(); it != files.end();
+       ++it) {
+    ifstream *fi = new ifstream((*it).c_str());
+    if (!*fi) {
+      s << PACKAGE << ": não foi possível abrir o arquivo: \"" << (*it) << "\""
+        << endl;
+      _errors = s.str();
+      delete fi;
+      goto bail;
+    }
+    istream_list.push_back(pair<string, istream *>(*it, fi));
+  }
+
+  success = parse(istream_list);
+
+bail:
+  for (list<pair<string, istream *>>::iterator it = istream_list.begin();
+       it != istream_list.end(); ++it) {
+    delete (*it).second;
+  }
+  return success;
+}
+
+// analise sintatica de um arquivo, feita em uma thread propria
+class ParsedFile {
+public:
+  ParsedFile() : in(0), useCache(true) {}
+
+  string name;
+  istream *in;
+  bool useCache; // procura/atualiza a forma pre-compilada (LibraryCache)
+  GPTDisplay display; // erros deste arquivo
+  RefPortugolAST ast;
+  string content;   // conteudo (arquivos de funcoes)
+  string algorithm; // nome do algoritmo (primeiro arquivo)
+  string internalError;
+};
+
+// o primeiro arquivo contem o algoritmo; os demais, apenas funcoes. Estes
+// sao lidos da forma pre-compilada quando ela existe e corresponde ao
+// conteudo; se estiver desatualizada, e' refeita
+static void parseFile(ParsedFile &f, bool isMain) {
+  try {
+    f.display.addFileName(f.name);
+    f.display.setCurrentFile(f.name);
+
+    istream *in = f.in;
+    istringstream text;
+    string cachefile = LibraryCache::cacheName(f.name);
+    bool stale = false;
+    if (!isMain) {
+      stringstream buf;
+      buf << f.in->rdbuf();
+      f.content = buf.str();
+      if (f.useCache) {
+        if (LibraryCache::load(cachefile, f.name, f.content, f.ast)) {
+          return;
+        }
+        stale = ifstream(cachefile.c_str()).good();
+      }
+      text.str(f.content);
+      in = &text;
+    }
+
+    PortugolLexer lexer(*in, f.display);
+    lexer.setFilename(f.name);
+
+    PortugolParser parser(lexer);
+    parser.setDisplay(f.display);
+
+    ASTFactory ast_factory(PortugolAST::TYPE_NAME, &PortugolAST::factory);
+    parser.initializeASTFactory(ast_factory);
+    parser.setASTFactory(&ast_factory);
+
+    if (isMain) {
+      parser.algoritmo();
+      f.algorithm = parser.nomeAlgoritmo();
+    } else {
+      parser.biblioteca();
+    }
+    f.ast = parser.getPortugolAST();
+
+    if (stale && !f.display.hasError()) {
+      LibraryCache::save(cachefile, f.content, f.ast);
+    }
+  } catch (TooManyErrorsException &) {
+  } catch (ANTLRException &e) {
+    f.internalError = e.toString();
+  } catch (exception &e) {
+    f.internalError = e.what();
+  }
+}
+
+bool CompiledProgram::parse(list<pair<string, istream *>> &istream_list) {
+  stringstream s;
+  chrono::steady_clock::time_point t = chrono::steady_clock::now();
+
+  _errors.clear();
+  _display.clear();
+
+  if (istream_list.empty()) {
+    s << PACKAGE << ": nenhum arquivo especificado." << endl;
+    _errors = s.str();
+    return false;
+  }
+
+  try {
+    // cada arquivo e' analisado com seu lexer, parser e GPTDisplay. Ate
+    // _parseJobs threads (contando esta) pegam o proximo arquivo ainda nao
+    // analisado; com um unico arquivo, nenhuma thread e' criada
+    vector<ParsedFile> files(istream_list.size());
+    int c = 0;
+    for (list<pair<string, istream *>>::iterator it = istream_list.begin();
+         it != istream_list.end(); ++it, ++c) {
+      files[c].name = (*it).first;
+      files[c].in = (*it).second;
+    }
+
+    atomic<unsigned> next(0);
+    auto worker = [&]() {
+      unsigned i;
+      while ((i = next++) < files.size()) {
+        parseFile(files[i], i == 0);
+      }
+    };
+
+    unsigned jobs = _parseJobs;
+    if (jobs == 0) {
+      jobs = thread::hardware_concurrency();
+    }
+    if (jobs > files.size()) {
+      jobs = files.size();
+    }
+    vector<thread> threads;
+    for (unsigned t = 1; t < jobs; t++) {
+      threads.push_back(thread(worker));
+    }
+    worker();
+    for (unsigned t = 0; t < threads.size(); t++) {
+      threads[t].join();
+    }
+    _phases.push_back(make_pair(string("analise_sintatica"), lap(t)));
+    _name = files[0].algorithm;
+
+    // erros na ordem dos arquivos (errorsToString percorre os indices de
+    // addFileName do maior para o menor)
+    for (int i = files.size() - 1; i >= 0; i--) {
+      _display.addFileName(files[i].name);
+    }
+    for (unsigned i = 0; i < files.size(); i++) {
+      if (!files[i].internalError.empty()) {
+        s << PACKAGE << ": erro interno: " << files[i].internalError << endl;
+        _errors = s.str();
+        return false;
+      }
+      _display.merge(files[i].display);
+    }
+    _display.setCurrentFile(files[0].name);
+
+    if (_display.hasError()) {
+      _errors = _display.errorsToString();
+      return false;
+    }
+
+    _astree = files[0].ast;
+
+    if (!_astree) {
+      s << PACKAGE << ": erro interno: no parse tree" << endl;
+      _errors = s.str();
+      return false;
+    }
+
+    // funcoes dos demais arquivos entram no fim da lista de declaracoes do
+    // algoritmo, como se estivessem no mesmo arquivo
+    RefPortugolAST last = _astree;
+    for (unsigned i = 1; i < files.size(); i++) {
+      if (!files[i].ast) {
+        continue; // arquivo sem funcoes
+      }
+      while (last->getNextSibling()) {
+        last = last->getNextSibling();
+      }
+      last->setNextSibling(files[i].ast);
+    }
+
+    if (_printParseTree) {
+      std::cerr << _astree->toStringList() << std::endl << std::endl;
+    }
+
+    {
+      lock_guard<mutex> lock(treeParserMutex());
+      SemanticWalker semantic(_stable, _display);
+      semantic.algoritmo(_astree);
+    }
+    _phases.push_back(make_pair(string("analise_semantica"), lap(t)));
+
+    if (_display.hasError()) {
+      _errors = _display.errorsToString();
+      return false;
+    }
+
+    ASTOptimizer optimizer;
+    optimizer.optimize(_astree);
+    _phases.push_back(make_pair(string("otimizacao"), lap(t)));
+    return true;
+  } catch (TooManyErrorsException &) {
+    _errors = _display.errorsToString();
+    return false;
+  } catch (ANTLRException &e) {
+    s << PACKAGE << ": erro interno: " << e.toString() << endl;
+  } catch (exception &e) {
+    s << PACKAGE << ": erro interno: " << e.what() << endl;
+  }
+
+  _errors = s.str();
+  return false;
+}
+
+bool CompiledProgram::precompile(const string &file, const string &cachefile,
+                                 string &errors) {
+  stringstream s;
+  ifstream fi(file.c_str());
+  if (!fi) {
+    s << PACKAGE << ": não foi possível abrir o arquivo: \"" << file << "\""
+      << endl;
+    errors = s.str();
+    return false;
+  }
+
+  ParsedFile f;
+  f.name = file;
+  f.in = &fi;
+  f.useCache = false;
+  parseFile(f, false);
+
+  if (!f.internalError.empty()) {
+    s << PACKAGE << ": erro interno: " << f.internalError << endl;
+    errors = s.str();
+    return false;
+  }
+  if (f.display.hasError()) {
+    errors = f.display.errorsToString();
+    return false;
+  }
+  if (!LibraryCache::save(cachefile, f.content, f.ast)) {
+    s << PACKAGE << ": não foi possível salvar o arquivo: \"" << cachefile
+      << "\"" << endl;
+    errors = s.str();
+    return false;
+  }
+  return true;
+}
+
+Bytecode &CompiledProgram::bytecode() {
+  if (!_program) {
+    chrono::steady_clock::time_point t = chrono::steady_clock::now();
+    _program = new Bytecode;
+    {
+      lock_guard<mutex> lock(treeParserMutex());
+      BytecodeWalker compiler(_stable, *_program);
+      compiler.algoritmo(_astree);
+    }
+    _phases.push_back(make_pair(string("compilacao"), lap(t)));
+  }
+  return *_program;
+}
+
+ExecutionResult CompiledProgram::run(istream &in, ostream &out,
+                                     const ExecutionLimits &limits) {
+  ExecutionResult r;
+
+  VirtualMachine vm(_stable, bytecode(), "", 0);
+  vm.setLimits(limits);
+  vm.setStreams(in, out);
+  try {
+    r.exitCode = vm.run();
+    r.result = "ok";
+  } catch (ExecutionError &e) {
+    r.result = e.result;
+    r.exitCode = e.exitCode;
+    r.message = e.message;
+  }
+  r.stats = vm.finish();
+  return r;
+}
@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef COMPILEDPROGRAM_HPP
+#define COMPILEDPROGRAM_HPP
+
+#include <istream>
+#include <list>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ExecutionLimits.hpp"
+#include "GPTDisplay.hpp"
+#include "PortugolAST.hpp"
+#include "RuntimeStats.hpp"
+#include "SymbolTable.hpp"
+
+using namespace std;
+
+class Bytecode;
+
+// resultado de CompiledProgram::run
+class ExecutionResult {
+public:
+  ExecutionResult() : exitCode(0) {}
+
+  string result;  // "ok", "erro" ou "limite" (como em --stats)
+  int exitCode;   // retorno do algoritmo, ou o codigo de saida de "gpt -i"
+  string message; // mensagem do erro de execucao (result != "ok")
+  RuntimeStats stats;
+};
+
+// algoritmo analisado uma unica vez, que pode ser executado varias vezes no
+// mesmo processo, cada execucao com sua entrada, saida e limites. E' a
+// interface de libgportugol para quem embute o interpretador:
+//
+//   CompiledProgram prog;
+//   if (!prog.parseFiles(arquivos)) {
+//     cerr << prog.errors();
+//   }
+//   ExecutionResult r = prog.run(entrada, saida, limites);
+//
+// Erros de execucao e limites excedidos sao retornados em ExecutionResult,
+// sem encerrar o processo. Cada objeto tem seus proprios erros e tabela de
+// simbolos; objetos diferentes podem ser analisados e executados em threads
+// diferentes ao mesmo tempo (as fases que percorrem a arvore com tree
+// parsers do ANTLR rodam uma de cada vez, ver treeParserMutex).
+class CompiledProgram {
+public:
+  CompiledProgram();
+  ~CompiledProgram();
+
+  // sources: pares (nome do arquivo, conteudo). O primeiro contem o
+  // algoritmo e os demais apenas funcoes; sao analisados em paralelo (ver
+  // parseJobs).
+  // Em caso de erro, retorna false e as mensagens ficam em errors(). Deve ser
+  // chamada uma unica vez
+  bool parse(list<pair<string, istream *>> &sources);
+  bool parseFiles(const list<string> &files);
+
+  // grava em cachefile a forma pre-compilada de um arquivo de funcoes
+  // (LibraryCache), usada em vez do fonte pelas analises seguintes
+  static bool precompile(const string &file, const string &cachefile,
+                         string &errors);
+
+  void printParseTree(bool value) { _printParseTree = value; }
+
+  // threads usadas por parse; 0 (padrao) usa o numero de processadores
+  void parseJobs(unsigned value) { _parseJobs = value; }
+  void showTips(bool value) { _display.showTips(value); } // dicas nos erros
+
+  const string &errors() const { return _errors; }
+  const string &name() const { return _name; } // nome do algoritmo
+
+  // tempo (segundos) de cada fase da analise e da geracao do bytecode
+  const vector<pair<string, double>> &phases() const { return _phases; }
+
+  RefPortugolAST ast() { return _astree; }
+  SymbolTable &symbols() { return _stable; }
+
+  // gerado na primeira chamada
+  Bytecode &bytecode();
+
+  ExecutionResult run(istream &in, ostream &out,
+                      const ExecutionLimits &limits = ExecutionLimits());
+
+  // os tree parsers do ANTLR 2 compartilham TreeParser::ASTNULL, cujo
+  // contador de referencias nao e' atomico. Quem usa um tree parser em uma
+  // thread (da construcao a destruicao) deve manter este mutex
+  static mutex &treeParserMutex();
+
+private:
+  CompiledProgram(const CompiledProgram &);
+  CompiledProgram &operator=(const CompiledProgram &);
+
+  bool _printParseTree;
+  unsigned _parseJobs;
+  string _errors;
+  string _name;
+  vector<pair<string, double>> _phases;
+  GPTDisplay _display;
+
+  RefPortugolAST _astree;
+  SymbolTable _stable;
+  Bytecode *_program;
+};
+
+#endif
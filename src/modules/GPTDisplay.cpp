@@ -29,8 +29,6 @@
 
 using namespace std;
 
-GPTDisplay *GPTDisplay::_self = 0L;
-
 GPTDisplay::GPTDisplay()
     : MAX_ERRORS(10), _totalErrors(0), _stopOnError(false), _showTips(false) {}
 
@@ -81,32 +79,31 @@ void GPTDisplay::stopOnError(bool val) { _stopOnError = val; }
 
 bool GPTDisplay::hasError() { return _totalErrors > 0; }
 
-void GPTDisplay::showErrors() {
+void GPTDisplay::showErrors() { cerr << toOEM(errorsToString()); }
+
+string GPTDisplay::errorsToString() {
+  stringstream s;
   errors_map_t::reverse_iterator it;
   for (it = _errors.rbegin(); it != _errors.rend(); ++it) {
     for (map<int, list<ErrorMsg>>::iterator ll = it->second.begin();
          ll != it->second.end(); ++ll) {
       for (list<ErrorMsg>::iterator lit = ll->second.begin();
            lit != ll->second.end(); ++lit) {
-        showError((*lit));
+        formatError(s, (*lit));
         if (_showTips && (*lit).hasTip) {
-          showTip((*lit));
+          formatTip(s, (*lit));
         }
       }
     }
   }
-}
-
-GPTDisplay *GPTDisplay::self() {
-  if (!GPTDisplay::_self) {
-    GPTDisplay::_self = new GPTDisplay();
-  }
-  return GPTDisplay::_self;
+  return s.str();
 }
 
 void GPTDisplay::addFileName(const string &str) {
-  static int c = 0;
-  _file_map[str] = c++;
+  if (_file_map.find(str) == _file_map.end()) {
+    int c = _file_map.size();
+    _file_map[str] = c;
+  }
 }
 
 int GPTDisplay::add(const string &msg, int line) {
@@ -115,8 +112,7 @@ int GPTDisplay::add(const string &msg, int line) {
     throw UniqueErrorException(msg, line);
 
   if (totalErrors() > MAX_ERRORS) {
-    showErrors();
-    exit(1);
+    throw TooManyErrorsException();
   }
 
   ErrorMsg err;
@@ -131,16 +127,12 @@ int GPTDisplay::add(const string &msg, int line) {
   // return _errors[line].size();
 }
 
-void GPTDisplay::showError(ErrorMsg &err) {
-  stringstream s;
-  s << err.file << ":" << err.line << " - " << err.msg << "." << endl;
-  showError(s);
+void GPTDisplay::formatError(ostream &out, ErrorMsg &err) {
+  out << err.file << ":" << err.line << " - " << err.msg << "." << endl;
 }
 
-void GPTDisplay::showTip(ErrorMsg &err) {
-  stringstream s;
-  s << "\tDica: " << err.tip << "." << endl;
-  showError(s);
+void GPTDisplay::formatTip(ostream &out, ErrorMsg &err) {
+  out << "\tDica: " << err.tip << "." << endl;
 }
 
 void GPTDisplay::addTip(const string &msg, int line, int cd) {
@@ -153,6 +145,20 @@ void GPTDisplay::addTip(const string &msg, int line, int cd) {
   (*it).tip = msg;
 }
 
+void GPTDisplay::merge(GPTDisplay &other) {
+  for (errors_map_t::iterator it = other._errors.begin();
+       it != other._errors.end(); ++it) {
+    for (map<int, list<ErrorMsg>>::iterator ll = it->second.begin();
+         ll != it->second.end(); ++ll) {
+      for (list<ErrorMsg>::iterator lit = ll->second.begin();
+           lit != ll->second.end(); ++lit) {
+        _errors[_file_map[(*lit).file]][ll->first].push_back(*lit);
+      }
+    }
+  }
+  _totalErrors += other._totalErrors;
+}
+
 void GPTDisplay::setCurrentFile(const string &file) { _currentFile = file; }
 
 string GPTDisplay::getCurrentFile() { return _currentFile; }
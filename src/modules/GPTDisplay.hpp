@@ -43,6 +43,12 @@ private:
   int _line;
 };
 
+// lancada por GPTDisplay::add quando o numero de erros excede MAX_ERRORS
+class TooManyErrorsException {};
+
+// erros de uma compilacao. Cada analise (CompiledProgram) tem o seu, passado
+// ao lexer, ao parser e ao analisador semantico. As funcoes estaticas apenas
+// exibem mensagens e podem ser usadas de qualquer lugar.
 class GPTDisplay {
 public:
   const int MAX_ERRORS;
@@ -58,13 +64,12 @@ public:
     string tip;
   };
 
+  GPTDisplay();
   ~GPTDisplay();
 
-  static GPTDisplay *self();
-
-  void showError(stringstream &s);
-  void showError(const string &);
-  void showMessage(stringstream &s);
+  static void showError(stringstream &s);
+  static void showError(const string &);
+  static void showMessage(stringstream &s);
 
   void stopOnError(bool);
 
@@ -73,6 +78,10 @@ public:
   int add(const string &msg, int line);
   void addTip(const string &msg, int line, int cd);
 
+  // acrescenta os erros de outro GPTDisplay (analise de um arquivo em outra
+  // thread). Os arquivos devem ter sido registrados com addFileName
+  void merge(GPTDisplay &other);
+
   void setCurrentFile(const string &file);
   string getCurrentFile();
   //   void addInternalError(const string&);
@@ -81,6 +90,7 @@ public:
   ErrorMsg getFirstError();
 
   void showErrors();
+  string errorsToString(); // os erros, como exibidos por showErrors()
   bool hasError();
 
   int totalErrors();
@@ -90,15 +100,11 @@ public:
   void clear();
 
 private:
-  GPTDisplay();
-
-  static GPTDisplay *_self;
-
-  string toOEM(const string &str);
-  string toLatin1(const string &);
+  static string toOEM(const string &str);
+  static string toLatin1(const string &);
 
-  void showError(ErrorMsg &);
-  void showTip(ErrorMsg &);
+  void formatError(ostream &out, ErrorMsg &);
+  void formatTip(ostream &out, ErrorMsg &);
 
   void processAndAdd(const string &, int);
   void processTipAndAdd(const string &msg, int line, int cd);
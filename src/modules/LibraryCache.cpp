@@ -0,0 +1,216 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "LibraryCache.hpp"
+#include "config.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <thread>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+// formato: "GPTC", versao do formato (4 bytes), hash (8 bytes) e os nodos em
+// pre-ordem. Cada nodo: flags (1 byte: tem filho, tem irmao), tipo, linha,
+// linha final, tamanho do texto (4 bytes cada) e o texto
+static const char MAGIC[4] = {'G', 'P', 'T', 'C'};
+static const unsigned FORMAT = 1;
+
+enum { HAS_CHILD = 1, HAS_SIBLING = 2 };
+
+static void put32(string &out, unsigned v) {
+  for (int i = 0; i < 4; i++) {
+    out += (char)((v >> (8 * i)) & 0xff);
+  }
+}
+
+static void put64(string &out, unsigned long long v) {
+  for (int i = 0; i < 8; i++) {
+    out += (char)((v >> (8 * i)) & 0xff);
+  }
+}
+
+static void encode(string &out, RefPortugolAST node) {
+  for (; node; node = node->getNextSibling()) {
+    RefPortugolAST child = node->getFirstChild();
+    RefPortugolAST next = node->getNextSibling();
+    out += (char)((child ? HAS_CHILD : 0) | (next ? HAS_SIBLING : 0));
+    put32(out, node->getType());
+    put32(out, node->getLine());
+    put32(out, node->getEndLine());
+    string text = node->getText();
+    put32(out, text.length());
+    out += text;
+    if (child) {
+      encode(out, child);
+    }
+  }
+}
+
+// leitura com verificacao de limites (arquivo truncado ou corrompido)
+class Reader {
+public:
+  Reader(const string &d) : data(d), pos(0), ok(true) {}
+
+  unsigned get8() {
+    if (pos + 1 > data.length()) {
+      ok = false;
+      return 0;
+    }
+    return (unsigned char)data[pos++];
+  }
+
+  unsigned get32() {
+    unsigned v = 0;
+    for (int i = 0; i < 4; i++) {
+      v |= get8() << (8 * i);
+    }
+    return v;
+  }
+
+  unsigned long long get64() {
+    unsigned long long v = 0;
+    for (int i = 0; i < 8; i++) {
+      v |= (unsigned long long)get8() << (8 * i);
+    }
+    return v;
+  }
+
+  string getString(unsigned len) {
+    if (len > data.length() - pos) {
+      ok = false;
+      return "";
+    }
+    pos += len;
+    return data.substr(pos - len, len);
+  }
+
+  const string &data;
+  string::size_type pos;
+  bool ok;
+};
+
+static RefPortugolAST decode(Reader &in, const string &file) {
+  RefPortugolAST first;
+  RefPortugolAST last;
+  unsigned flags;
+  do {
+    flags = in.get8();
+    RefPortugolAST node(new PortugolAST);
+    node->setType((int)in.get32());
+    node->setLine((int)in.get32());
+    node->setEndLine((int)in.get32());
+    node->setText(in.getString(in.get32()));
+    node->setFilename(file);
+    if (!in.ok) {
+      return RefPortugolAST();
+    }
+    if (flags & HAS_CHILD) {
+      RefPortugolAST child = decode(in, file);
+      if (!child) {
+        return RefPortugolAST();
+      }
+      node->setFirstChild(child);
+    }
+    if (last) {
+      last->setNextSibling(node);
+    } else {
+      first = node;
+    }
+    last = node;
+  } while (flags & HAS_SIBLING);
+  return first;
+}
+
+string LibraryCache::cacheName(const string &file) { return file + "c"; }
+
+unsigned long long LibraryCache::hash(const string &content) {
+  unsigned long long h = 14695981039346656037ULL;
+  string data = content + '\0' + VERSION;
+  for (string::size_type i = 0; i < data.length(); i++) {
+    h ^= (unsigned char)data[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+bool LibraryCache::load(const string &cachefile, const string &file,
+                        const string &content, RefPortugolAST &ast) {
+  ifstream fi(cachefile.c_str(), ios_base::in | ios_base::binary);
+  if (!fi) {
+    return false;
+  }
+  stringstream buf;
+  buf << fi.rdbuf();
+  string data = buf.str();
+
+  Reader in(data);
+  string magic = in.getString(sizeof(MAGIC));
+  if (!in.ok || (magic != string(MAGIC, sizeof(MAGIC))) ||
+      (in.get32() != FORMAT) || (in.get64() != hash(content)) || !in.ok) {
+    return false;
+  }
+
+  if (in.pos == data.length()) { // arquivo sem funcoes
+    ast = RefPortugolAST();
+    return true;
+  }
+
+  RefPortugolAST tree = decode(in, file);
+  if (!tree || (in.pos != data.length())) {
+    return false;
+  }
+  ast = tree;
+  return true;
+}
+
+bool LibraryCache::save(const string &cachefile, const string &content,
+                        RefPortugolAST ast) {
+  string out(MAGIC, sizeof(MAGIC));
+  put32(out, FORMAT);
+  put64(out, hash(content));
+  if (ast) {
+    encode(out, ast);
+  }
+
+  // outro processo pode estar lendo cachefile, e outras threads deste
+  // (--separate) podem estar refazendo o mesmo arquivo
+  stringstream tmp;
+  tmp << cachefile << ".tmp";
+#ifndef WIN32
+  tmp << "." << getpid();
+#endif
+  tmp << "." << this_thread::get_id();
+  ofstream fo(tmp.str().c_str(), ios_base::out | ios_base::binary);
+  if (!fo) {
+    return false;
+  }
+  fo << out;
+  fo.close();
+  if (!fo || (rename(tmp.str().c_str(), cachefile.c_str()) != 0)) {
+    remove(tmp.str().c_str());
+    return false;
+  }
+  return true;
+}
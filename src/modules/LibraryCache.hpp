@@ -0,0 +1,53 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef LIBRARYCACHE_HPP
+#define LIBRARYCACHE_HPP
+
+#include "PortugolAST.hpp"
+
+#include <string>
+
+using namespace std;
+
+// forma pre-compilada de um arquivo de funcoes (como lib/base.gpt): a AST
+// produzida pelo parser, gravada em binario em "<arquivo>c" (base.gptc).
+// O arquivo e' identificado por um hash do conteudo do fonte e da versao do
+// gpt; se nao corresponder, o fonte e' analisado normalmente.
+class LibraryCache {
+public:
+  // base.gpt -> base.gptc
+  static string cacheName(const string &file);
+
+  // FNV-1a 64 de content e VERSION
+  static unsigned long long hash(const string &content);
+
+  // le a AST de cachefile, se ela corresponder a content. Os nodos recebem
+  // file como nome do arquivo
+  static bool load(const string &cachefile, const string &file,
+                   const string &content, RefPortugolAST &ast);
+
+  // grava a AST de content em cachefile (via arquivo temporario e rename)
+  static bool save(const string &cachefile, const string &content,
+                   RefPortugolAST ast);
+};
+
+#endif
@@ -19,19 +19,27 @@
  ***************************************************************************/
 
 #include "PortugolAST.hpp"
-#include "GPTDisplay.hpp"
+#include "PortugolToken.hpp"
 #include <iostream>
 
 const char *const PortugolAST::TYPE_NAME = "PortugolAST";
 
-PortugolAST::PortugolAST() : CommonAST(), line(-1), endLine(-1) {}
+PortugolAST::PortugolAST()
+    : CommonAST(), line(-1), endLine(-1), eval_type(-1), slot(-1),
+      globalSlot(false), invariantBound(false) {}
 
-PortugolAST::PortugolAST(RefToken t) : CommonAST(t), line(t->getLine()) {}
+PortugolAST::PortugolAST(RefToken t)
+    : CommonAST(t), line(t->getLine()), eval_type(-1), slot(-1),
+      globalSlot(false), invariantBound(false) {}
 
-PortugolAST::PortugolAST(const CommonAST &other) : CommonAST(other), line(-1) {}
+PortugolAST::PortugolAST(const CommonAST &other)
+    : CommonAST(other), line(-1), eval_type(-1), slot(-1), globalSlot(false),
+      invariantBound(false) {}
 
 PortugolAST::PortugolAST(const PortugolAST &other)
-    : CommonAST(other), line(other.line) {}
+    : CommonAST(other), line(other.line), eval_type(other.eval_type),
+      slot(other.slot), globalSlot(other.globalSlot),
+      invariantBound(other.invariantBound) {}
 
 PortugolAST::~PortugolAST() {}
 
@@ -43,7 +51,10 @@ RefAST PortugolAST::clone(void) const {
 const char *PortugolAST::typeName(void) const { return PortugolAST::TYPE_NAME; }
 
 void PortugolAST::initialize(RefToken t) {
-  setFilename(GPTDisplay::self()->getCurrentFile());
+  PortugolToken *tk = dynamic_cast<PortugolToken *>(t.get());
+  if (tk) {
+    setFilename(tk->getSourceFile());
+  }
   CommonAST::initialize(t);
   setLine(t->getLine());
 }
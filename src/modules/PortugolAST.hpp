@@ -47,7 +47,22 @@ public:
 
   void setFilename(const string &fname) { filename = fname; }
 
-  string getFilename() { return filename; }
+  // variavel resolvida pela analise semantica (escopo global/local e posicao)
+  // ou, em chamadas de funcao, indice da funcao chamada (Symbol::slot);
+  // em literais, numero da constante
+  void setSlot(bool global, int s) {
+    globalSlot = global;
+    slot = s;
+  }
+  int getSlot() { return slot; }
+  bool isGlobalSlot() { return globalSlot; }
+
+  // "para" cujo limite ("ate") nao muda durante o laco, podendo ser avaliado
+  // uma unica vez (ver SemanticEval::evaluateParaBound)
+  void setInvariantBound(bool inv) { invariantBound = inv; }
+  bool hasInvariantBound() { return invariantBound; }
+
+  const string &getFilename() { return filename; }
 
   virtual RefAST clone(void) const;
 
@@ -61,7 +76,10 @@ public:
 protected:
   int line;
   int endLine;
-  int eval_type; // evaluated type of expression
+  int eval_type; // evaluated type of expression (-1 se nao avaliada)
+  int slot;
+  bool globalSlot;
+  bool invariantBound;
   string filename;
 };
 
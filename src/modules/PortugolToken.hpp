@@ -0,0 +1,46 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef PORTUGOLTOKEN_HPP
+#define PORTUGOLTOKEN_HPP
+
+#include <antlr/CommonToken.hpp>
+#include <string>
+
+using namespace std;
+using namespace antlr;
+
+// token que guarda o arquivo de onde foi lido (ver PortugolLexer::makeToken),
+// repassado aos nodos da AST em PortugolAST::initialize
+class PortugolToken : public CommonToken {
+public:
+  PortugolToken() : CommonToken() {}
+
+  void setSourceFile(const string &f) { sourceFile = f; }
+  const string &getSourceFile() const { return sourceFile; }
+
+  static RefToken factory() { return RefToken(new PortugolToken); }
+
+private:
+  string sourceFile;
+};
+
+#endif
@@ -58,20 +58,20 @@ string SymbolType::toString() const {
   return str.str();
 }
 
-//------------------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
 
 Symbol::Symbol()
-    : cd(-1), scope(), lexeme(), line(-1), type(TIPO_NULO), isFunction(false),
-      isBuiltin(false), param() {}
+    : cd(-1), slot(-1), scope(), lexeme(), line(-1), type(TIPO_NULO),
+      isFunction(false), isBuiltin(false), param() {}
 
 Symbol::Symbol(const string &scope_, const string &lexeme_, int line_,
                bool isfunction_)
-    : cd(-1), scope(scope_), lexeme(lexeme_), line(line_), type(TIPO_NULO),
-      isFunction(isfunction_), isBuiltin(false), param() {}
+    : cd(-1), slot(-1), scope(scope_), lexeme(lexeme_), line(line_),
+      type(TIPO_NULO), isFunction(isfunction_), isBuiltin(false), param() {}
 
 Symbol::Symbol(const string &scope_, const string &lexeme_, int line_,
                bool isfunction_, int type_)
-    : cd(-1), scope(scope_), lexeme(lexeme_), line(line_), type(),
+    : cd(-1), slot(-1), scope(scope_), lexeme(lexeme_), line(line_), type(),
       isFunction(isfunction_), isBuiltin(false), param() {
 
   type.setPrimitive(true);
@@ -80,7 +80,7 @@ Symbol::Symbol(const string &scope_, const string &lexeme_, int line_,
 
 Symbol::Symbol(const string &scope_, const string &lexeme_, int line_,
                bool isfunction_, int type_, const list<int> &dimensions)
-    : cd(-1), scope(scope_), lexeme(lexeme_), line(line_), type(),
+    : cd(-1), slot(-1), scope(scope_), lexeme(lexeme_), line(line_), type(),
       isFunction(isfunction_), isBuiltin(false) {
 
   type.setPrimitiveType(type_);
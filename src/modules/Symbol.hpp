@@ -117,6 +117,7 @@ public:
   // attrs
 
   int cd;
+  int slot; // posicao da variavel no seu escopo (ou indice da funcao)
   string scope;
   string lexeme;
   int line;
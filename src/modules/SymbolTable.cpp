@@ -23,7 +23,7 @@
 
 string SymbolTable::GlobalScope = "@global";
 
-SymbolTable::SymbolTable() : currentCod(0) {
+SymbolTable::SymbolTable() : currentCod(0), functions(0) {
   // builtin functions
   registrarLeia();
   registrarImprima();
@@ -50,6 +50,7 @@ void SymbolTable::declareVar(const string &scope, const string &lexeme,
                              int line, int type) {
   Symbol s(scope, lexeme, line, false, type);
   s.cd = currentCod++;
+  s.slot = slots[scope]++;
   symbols[scope].push_back(s);
 }
 
@@ -58,11 +59,15 @@ void SymbolTable::declareVar(const string &scope, const string &lexeme,
 
   Symbol s(scope, lexeme, line, false, type, dimensions);
   s.cd = currentCod++;
+  s.slot = slots[scope]++;
   symbols[scope].push_back(s);
 }
 
 void SymbolTable::insertSymbol(Symbol &s, const string &scope) {
   s.cd = currentCod++;
+  if (s.isFunction) {
+    s.slot = functions++;
+  }
   symbols[scope].push_back(s);
 }
 
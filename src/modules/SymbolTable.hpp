@@ -64,6 +64,8 @@ protected:
 
   int currentCod;
   map<string, list<Symbol>> symbols; // map<scope, symbols>
+  map<string, int> slots;            // map<scope, total de variaveis>
+  int functions;                     // total de funcoes (incluindo builtins)
 };
 
 #endif
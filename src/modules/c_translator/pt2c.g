@@ -810,21 +810,33 @@ stm_para
   bool haspasso = false;
   production var, de, ate, ps;
   stringstream str;
+  string bound;
 }
-  : #(T_KW_PARA var=lvalue de=expr[TIPO_INTEIRO] ate=expr[TIPO_INTEIRO] (ps=passo {haspasso=true;})?
+  : #(para:T_KW_PARA var=lvalue de=expr[TIPO_INTEIRO] ate=expr[TIPO_INTEIRO] (ps=passo {haspasso=true;})?
       {
+        bound = ate.expr.second;
+        if(para->hasInvariantBound()) {
+          //limite invariante: avaliado uma unica vez (ver semantic.g)
+          writeln("{");
+          indent();
+          str << "int para_ate = " << bound << ";";
+          writeln(str);
+          str.str("");
+          bound = "para_ate";
+        }
+
         if(!haspasso) {
             str  << "for(" <<    var.lvalue.second << "=" << de.expr.second << ";"
-                              << var.lvalue.second << "<=" << ate.expr.second << ";"
+                              << var.lvalue.second << "<=" << bound << ";"
                               << var.lvalue.second << "+=" << 1 << ") {";
         } else {
           if(ps.passo.first) {//crescente
             str  << "for(" << var.lvalue.second << "=" << de.expr.second << ";"
-                              << var.lvalue.second << "<=" << ate.expr.second << ";"
+                              << var.lvalue.second << "<=" << bound << ";"
                               << var.lvalue.second << "+=" << ps.passo.second << ") {";
           } else { //decrescente
             str  << "for(" << var.lvalue.second << "=" << de.expr.second << ";"
-                              << var.lvalue.second << ">=" << ate.expr.second << ";"
+                              << var.lvalue.second << ">=" << bound << ";"
                               << var.lvalue.second << "-=" << ps.passo.second << ") {";
           }
         }
@@ -836,8 +848,12 @@ stm_para
       unindent();
       writeln("}");
       str.str("");
-      str << var.lvalue.second << " = " << ate.expr.second << ";";
+      str << var.lvalue.second << " = " << bound << ";";
       writeln(str);
+      if(para->hasInvariantBound()) {
+        unindent();
+        writeln("}");
+      }
     }
     )
   ;
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "Bytecode.hpp"
+
+int Bytecode::emit(int op, int a, int b) {
+  Instruction i;
+  i.op = op;
+  i.a = a;
+  i.b = b;
+  code.push_back(i);
+  return code.size() - 1;
+}
+
+// classe do operando: inteiro (inteiro, caractere, logico), real ou literal
+enum { CLASS_INT, CLASS_REAL, CLASS_LIT, CLASS_OTHER };
+
+static int typeClass(int type) {
+  switch (type) {
+  case TIPO_INTEIRO:
+  case TIPO_CARACTERE:
+  case TIPO_LOGICO:
+    return CLASS_INT;
+  case TIPO_REAL:
+    return CLASS_REAL;
+  case TIPO_LITERAL:
+    return CLASS_LIT;
+  default:
+    return CLASS_OTHER;
+  }
+}
+
+// versoes especializadas de cada operacao (-1 quando nao existe)
+static const struct {
+  int op, iop, rop, lop;
+} typedOps[] = {
+    {Bytecode::OP_BIT_OU, Bytecode::OP_BIT_OU_I, -1, -1},
+    {Bytecode::OP_BIT_XOU, Bytecode::OP_BIT_XOU_I, -1, -1},
+    {Bytecode::OP_BIT_E, Bytecode::OP_BIT_E_I, -1, -1},
+    {Bytecode::OP_MOD, Bytecode::OP_MOD_I, -1, -1},
+    {Bytecode::OP_IGUAL, Bytecode::OP_IGUAL_I, Bytecode::OP_IGUAL_R,
+     Bytecode::OP_IGUAL_L},
+    {Bytecode::OP_DIF, Bytecode::OP_DIF_I, Bytecode::OP_DIF_R,
+     Bytecode::OP_DIF_L},
+    {Bytecode::OP_MAIOR, Bytecode::OP_MAIOR_I, Bytecode::OP_MAIOR_R, -1},
+    {Bytecode::OP_MENOR, Bytecode::OP_MENOR_I, Bytecode::OP_MENOR_R, -1},
+    {Bytecode::OP_MAIOR_EQ, Bytecode::OP_MAIOR_EQ_I, Bytecode::OP_MAIOR_EQ_R,
+     -1},
+    {Bytecode::OP_MENOR_EQ, Bytecode::OP_MENOR_EQ_I, Bytecode::OP_MENOR_EQ_R,
+     -1},
+    {Bytecode::OP_MAIS, Bytecode::OP_MAIS_I, Bytecode::OP_MAIS_R, -1},
+    {Bytecode::OP_MENOS, Bytecode::OP_MENOS_I, Bytecode::OP_MENOS_R, -1},
+    {Bytecode::OP_DIV, Bytecode::OP_DIV_I, Bytecode::OP_DIV_R, -1},
+    {Bytecode::OP_MULTIP, Bytecode::OP_MULTIP_I, Bytecode::OP_MULTIP_R, -1},
+    {Bytecode::OP_NEG, Bytecode::OP_NEG_I, Bytecode::OP_NEG_R, -1}};
+
+// emite a versao de op especializada para os tipos dos operandos (eval_type
+// dos nos da expressao), promovendo para real o operando inteiro quando
+// necessario. Combinacoes sem versao especializada (literais com outros
+// tipos, por exemplo) usam a operacao generica.
+void Bytecode::emitTyped(int op, int left, int right) {
+  int l = typeClass(left);
+  int r = typeClass(right);
+
+  bool ints = (l == CLASS_INT) && (r == CLASS_INT);
+  bool nums = ((l == CLASS_INT) || (l == CLASS_REAL)) &&
+              ((r == CLASS_INT) || (r == CLASS_REAL));
+  bool lits = (l == CLASS_LIT) && (r == CLASS_LIT);
+
+  int iop = -1, rop = -1, lop = -1;
+  for (unsigned i = 0; i < sizeof(typedOps) / sizeof(typedOps[0]); i++) {
+    if (typedOps[i].op == op) {
+      iop = typedOps[i].iop;
+      rop = typedOps[i].rop;
+      lop = typedOps[i].lop;
+      break;
+    }
+  }
+
+  if (ints && (iop != -1)) {
+    emit(iop);
+  } else if (nums && (rop != -1)) {
+    if ((op != OP_NEG) && (l == CLASS_INT)) {
+      emit(OP_TOREAL, 1);
+    }
+    if ((op != OP_NEG) && (r == CLASS_INT)) {
+      emit(OP_TOREAL, 0);
+    }
+    emit(rop);
+  } else if (lits && (lop != -1)) {
+    emit(lop);
+  } else {
+    emit(op);
+  }
+}
+
+int Bytecode::here() const { return code.size(); }
+
+void Bytecode::patch(int at, int target) { code[at].a = target; }
+
+int Bytecode::addConstant(const ExprValue &v) {
+  constants.push_back(v);
+  return constants.size() - 1;
+}
+
+int Bytecode::addFile(const string &file) {
+  map<string, int>::iterator it = fileIndex.find(file);
+  if (it != fileIndex.end()) {
+    return it->second;
+  }
+  files.push_back(file);
+  return fileIndex[file] = files.size() - 1;
+}
+
+void Bytecode::beginFunction(int func, const string &file, int params) {
+  if ((int)functions.size() <= func) {
+    functions.resize(func + 1);
+  }
+  Function &f = functions[func];
+  f.file = file;
+  f.entry = here();
+  f.params = params;
+}
@@ -0,0 +1,164 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+#include "InterpreterEval.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// programa compilado para a maquina virtual (ver bytecode.g e VirtualMachine)
+class Bytecode {
+public:
+  enum Opcode {
+    OP_LINE, // a: linha, b: arquivo
+    OP_PUSH, // a: constante
+    OP_POP,
+
+    OP_LOAD,   // a: global, b: slot
+    OP_LOADM,  // a: global, b: slot (matriz inteira: func(mat))
+    OP_LOADE,  // a: global, b: slot (indices na pilha)
+    OP_STORE,  // a: global, b: slot
+    OP_STOREE, // a: global, b: slot (indices e valor na pilha)
+
+    OP_OU,
+    OP_E,
+    OP_BIT_OU,
+    OP_BIT_XOU,
+    OP_BIT_E,
+    OP_IGUAL,
+    OP_DIF,
+    OP_MAIOR,
+    OP_MENOR,
+    OP_MAIOR_EQ,
+    OP_MENOR_EQ,
+    OP_MAIS,
+    OP_MENOS,
+    OP_DIV,
+    OP_MULTIP,
+    OP_MOD,
+    OP_NEG,
+    OP_NOT,
+    OP_BNOT,
+
+    OP_JMP, // a: destino
+    OP_JZ,  // a: destino
+
+    // e/ou em curto-circuito: se o operando esquerdo (topo) decide o
+    // resultado, o substitui pelo logico e salta para "a"
+    OP_OU_JMP, // a: destino
+    OP_E_JMP,  // a: destino
+
+    OP_CALL, // a: funcao (Symbol::slot), b: linha
+    OP_RET,  // a: RET_*
+    OP_LEIA, // a: tipo da variavel de destino (ou TIPO_LITERAL)
+    OP_IMPRIMA, // a: numero de argumentos
+
+    OP_FOR_REF,  // a: global, b: slot (indices na pilha)
+    OP_FOR_SET,  // valor inicial ("de") na pilha
+    OP_FOR_TEST, // a: destino, b: passo ("ate" na pilha)
+    OP_FOR_STEP, // a: passo
+    OP_FOR_END,
+
+    // "para" com limite invariante: "ate" e' avaliado uma unica vez
+    OP_FOR_BOUND, // "ate" na pilha
+    OP_FOR_CHECK, // a: destino (fim), b: passo
+    OP_FOR_NEXT,  // a: destino (corpo), b: passo
+
+    OP_LOOP, // fim de uma iteracao de laco: conta um passo (ExecutionLimits)
+
+    // especializadas pelos tipos dos operandos, resolvidos na analise
+    // semantica (ver emitTyped): _I para inteiro/caractere/logico, _R para
+    // real e _L para literal
+    OP_TOREAL, // a: 0 = topo da pilha, 1 = abaixo do topo
+    OP_BIT_OU_I,
+    OP_BIT_XOU_I,
+    OP_BIT_E_I,
+    OP_IGUAL_I,
+    OP_IGUAL_R,
+    OP_IGUAL_L,
+    OP_DIF_I,
+    OP_DIF_R,
+    OP_DIF_L,
+    OP_MAIOR_I,
+    OP_MAIOR_R,
+    OP_MENOR_I,
+    OP_MENOR_R,
+    OP_MAIOR_EQ_I,
+    OP_MAIOR_EQ_R,
+    OP_MENOR_EQ_I,
+    OP_MENOR_EQ_R,
+    OP_MAIS_I,
+    OP_MAIS_R,
+    OP_MENOS_I,
+    OP_MENOS_R,
+    OP_DIV_I,
+    OP_DIV_R,
+    OP_MULTIP_I,
+    OP_MULTIP_R,
+    OP_MOD_I,
+    OP_NEG_I,
+    OP_NEG_R,
+
+    OP_HALT, // a: 1 se existe valor de retorno na pilha
+
+    OP_COUNT
+  };
+
+  enum { RET_END, RET_VALUE, RET_NULL };
+
+  struct Instruction {
+    int op;
+    int a;
+    int b;
+  };
+
+  // indexadas por Symbol::slot (o mesmo indice usado por OP_CALL)
+  struct Function {
+    string file;
+    int entry;
+    int params;
+  };
+
+  int emit(int op, int a = 0, int b = 0);
+  void emitTyped(int op, int left, int right);
+  int here() const;
+  void patch(int at, int target);
+
+  int addConstant(const ExprValue &v);
+  int addFile(const string &file);
+
+  void beginFunction(int func, const string &file, int params);
+
+  vector<Instruction> code;
+  vector<ExprValue> constants;
+  vector<string> files;
+  vector<Function> functions;
+
+private:
+  map<string, int> fileIndex;
+};
+
+#endif
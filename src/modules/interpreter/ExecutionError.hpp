@@ -0,0 +1,43 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef EXECUTIONERROR_HPP
+#define EXECUTIONERROR_HPP
+
+#include <string>
+
+using namespace std;
+
+// lancada pelo interpretador quando a execucao e' abortada (erro de
+// execucao ou limite excedido). Quem executa o algoritmo decide o que
+// fazer: gpt -i exibe a mensagem e termina com exitCode; CompiledProgram
+// retorna o erro em ExecutionResult.
+class ExecutionError {
+public:
+  ExecutionError(const string &res, int code, const string &msg)
+      : result(res), exitCode(code), message(msg) {}
+
+  string result; // "erro" ou "limite" (como em --stats)
+  int exitCode;  // EXIT_FAILURE ou ExecutionLimits::EXIT_CODE
+  string message;
+};
+
+#endif
@@ -0,0 +1,47 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef EXECUTIONLIMITS_HPP
+#define EXECUTIONLIMITS_HPP
+
+// limites de execucao do interpretador (--max-depth, --max-steps,
+// --max-memory e --timeout). Zero indica ausencia de limite.
+class ExecutionLimits {
+public:
+  enum { DEFAULT_MAX_DEPTH = 100000 }; // chamadas de funcao aninhadas
+
+  // o interpretador de arvore (--tree-walker) usa a pilha do processo em
+  // cada chamada e a estoura muito antes do limite da maquina virtual
+  enum { DEFAULT_TREE_WALKER_MAX_DEPTH = 1000 };
+
+  // codigo de saida do processo quando um limite e' excedido
+  enum { EXIT_CODE = 3 };
+
+  ExecutionLimits()
+      : maxDepth(DEFAULT_MAX_DEPTH), maxSteps(0), maxMemory(0), timeout(0) {}
+
+  int maxDepth;
+  long long maxSteps;  // comandos executados e iteracoes de lacos
+  long long maxMemory; // bytes ocupados por matrizes
+  int timeout;         // segundos (tempo real)
+};
+
+#endif
@@ -0,0 +1,163 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "InputBuffer.hpp"
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
+
+InputBuffer::InputBuffer()
+    : pos(0), end(0), filled(0), stream(0), buffer(0), mapped(0) {
+#ifndef WIN32
+  struct stat st;
+  if ((fstat(0, &st) == 0) && S_ISREG(st.st_mode)) {
+    off_t start = lseek(0, 0, SEEK_CUR); // "gpt -i x.gpt < entrada.txt"
+    if ((start >= 0) && (start < st.st_size)) {
+      void *m = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, 0, 0);
+      if (m != MAP_FAILED) {
+        mapped = m;
+        mappedSize = st.st_size;
+        pos = (const char *)m + start;
+        end = (const char *)m + st.st_size;
+        filled = end - pos;
+        return;
+      }
+    }
+  }
+#endif
+  buffer = new char[BUFFER_SIZE];
+}
+
+InputBuffer::~InputBuffer() {
+#ifndef WIN32
+  if (mapped) {
+    munmap(mapped, mappedSize);
+  }
+#endif
+  delete[] buffer;
+}
+
+void InputBuffer::setStream(istream &in) {
+#ifndef WIN32
+  if (mapped) {
+    munmap(mapped, mappedSize);
+    mapped = 0;
+  }
+#endif
+  if (!buffer) {
+    buffer = new char[BUFFER_SIZE];
+  }
+  pos = end = 0;
+  filled = 0;
+  stream = &in;
+}
+
+bool InputBuffer::fill() {
+  if (mapped) {
+    return false;
+  }
+
+  int n;
+  if (stream) {
+    stream->read(buffer, BUFFER_SIZE);
+    n = stream->gcount();
+  } else {
+    n = read(0, buffer, BUFFER_SIZE);
+  }
+  if (n <= 0) {
+    return false;
+  }
+  pos = buffer;
+  end = buffer + n;
+  filled += n;
+  return true;
+}
+
+void InputBuffer::skipLine() {
+  int c;
+  while (((c = get()) != -1) && (c != '\n')) {
+  }
+}
+
+void InputBuffer::readLine(string &line) {
+  line.clear();
+  for (;;) {
+    if ((pos == end) && !fill()) {
+      return;
+    }
+
+    const char *nl = pos;
+    while ((nl != end) && (*nl != '\n')) {
+      nl++;
+    }
+    line.append(pos, nl - pos);
+
+    if (nl != end) {
+      pos = nl + 1;
+      return;
+    }
+    pos = end;
+  }
+}
+
+int InputBuffer::readInt() {
+  int c = get();
+  while ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\v') ||
+         (c == '\f')) {
+    c = get();
+  }
+
+  bool neg = false;
+  if ((c == '-') || (c == '+')) {
+    neg = (c == '-');
+    c = get();
+  }
+
+  unsigned int v = 0;
+  while ((c >= '0') && (c <= '9')) {
+    v = v * 10 + (c - '0');
+    c = get();
+  }
+
+  if ((c != '\n') && (c != -1)) {
+    skipLine();
+  }
+  return neg ? -(int)v : (int)v;
+}
+
+float InputBuffer::readReal() {
+  readLine(scratch);
+  return (float)atof(scratch.c_str());
+}
+
+int InputBuffer::readChar() {
+  int c = get();
+  if ((c == '\n') || (c == -1)) {
+    return 0;
+  }
+  skipLine();
+  return (char)c;
+}
@@ -0,0 +1,75 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef INPUTBUFFER_HPP
+#define INPUTBUFFER_HPP
+
+#include <istream>
+#include <string>
+
+using namespace std;
+
+// entrada padrao do interpretador (leia). Le blocos grandes de uma vez (ou
+// mapeia o arquivo em memoria, se a entrada for um arquivo regular) e
+// converte cada linha diretamente no tipo pedido.
+class InputBuffer {
+public:
+  InputBuffer();
+  ~InputBuffer();
+
+  // le de "in" em vez da entrada padrao (deve ser chamada antes da
+  // primeira leitura)
+  void setStream(istream &in);
+
+  void readLine(string &line);
+  int readInt();    // equivalente a atoi() aplicado a linha
+  float readReal(); // equivalente a atof() aplicado a linha
+  int readChar();   // primeiro caractere da linha (0 se vazia)
+
+  long long bytesRead() const { return filled - (end - pos); }
+
+private:
+  enum { BUFFER_SIZE = 64 * 1024 };
+
+  int get() { // proximo caractere ou -1 no fim da entrada
+    if ((pos == end) && !fill()) {
+      return -1;
+    }
+    return (unsigned char)*pos++;
+  }
+
+  bool fill();
+  void skipLine();
+
+  const char *pos;
+  const char *end;
+
+  long long filled; // bytes lidos da entrada ate agora
+
+  istream *stream; // ou 0, para a entrada padrao
+
+  char *buffer;
+  void *mapped; // arquivo mapeado em memoria (ou 0)
+  size_t mappedSize;
+
+  string scratch;
+};
+
+#endif
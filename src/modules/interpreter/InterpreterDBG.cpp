@@ -29,7 +29,6 @@
 #else
 #include <netdb.h>
 #include <netinet/in.h>
-#include <signal.h>
 #include <sys/socket.h>
 #endif
 
@@ -37,12 +36,13 @@
 #include <pcre2.h>
 #include <unistd.h>
 
-#ifndef WIN32
-void sigPipeHandler(int signum) { InterpreterDBG::self()->closeSock(); }
+// depurador que encerra a conexao nao deve matar o processo com SIGPIPE
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
 #endif
 
-InterpreterDBG *InterpreterDBG::singleton = NULL;
-
 InterpreterDBG::InterpreterDBG() {
   currentCmd = CMDNull;
 #ifndef WIN32
@@ -52,11 +52,10 @@ InterpreterDBG::InterpreterDBG() {
 #endif
 }
 
-InterpreterDBG *InterpreterDBG::self() {
-  if (!singleton) {
-    singleton = new InterpreterDBG;
+InterpreterDBG::~InterpreterDBG() {
+  if (isActive()) {
+    closeSock();
   }
-  return singleton;
 }
 
 void InterpreterDBG::init(string host, int port) {
@@ -83,7 +82,7 @@ void InterpreterDBG::init(string host, int port) {
   if (clientsock < 0) {
     stringstream s;
     s << PACKAGE << ": não foi possível criar socket\n";
-    GPTDisplay::self()->showError(s);
+    GPTDisplay::showError(s);
     return;
   }
 
@@ -92,11 +91,10 @@ void InterpreterDBG::init(string host, int port) {
     // unable to connect
     closeSock();
   } else {
-    if (SIG_ERR == signal(SIGPIPE, sigPipeHandler)) {
-      stringstream s;
-      s << PACKAGE << ": erro interno em InterpreterDBG::init" << endl;
-      GPTDisplay::self()->showError(s);
-    }
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    int on = 1;
+    setsockopt(clientsock, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
   }
 #else
   WORD wVersionRequested = MAKEWORD(1, 1);
@@ -201,7 +199,7 @@ void InterpreterDBG::sendStackInfo(list<pair<string, pair<string, int>>> &stk) {
   sendData(s);
 }
 
-void InterpreterDBG::sendVariables(map<string, Variable> globals,
+void InterpreterDBG::sendVariables(vector<Variable> &vars,
                                    list<pair<string, pair<string, int>>> &stk,
                                    bool globalScope) {
   if (clientsock < 0)
@@ -212,22 +210,20 @@ void InterpreterDBG::sendVariables(map<string, Variable> globals,
     << (globalScope ? stk.front().second.first : stk.back().first) << "\">";
 
   bool primitive;
-  for (map<string, Variable>::iterator it = globals.begin();
-       it != globals.end(); ++it) {
-    primitive = it->second.isPrimitive;
-    s << "<var name=\"" << it->first << "\" type=\""
-      << Symbol::typeToString(it->second.type) << "\" primitive=\""
+  for (vector<Variable>::iterator it = vars.begin(); it != vars.end(); ++it) {
+    primitive = it->isPrimitive;
+    s << "<var name=\"" << it->name << "\" type=\""
+      << Symbol::typeToString(it->type) << "\" primitive=\""
       << (primitive ? "true" : "false") << "\"";
     if (primitive) {
-      s << " value=\"" << it->second.primitiveValue << "\"/>";
+      s << " value=\"" << it->primitiveValue.toString() << "\"/>";
     } else {
       stringstream vv;
       s << "><values>";
 
       //       for(list<int>::iterator dit = it->second.dimensions.begin(); dit
       //       != it->second.dimensions.end(); ++dit) {
-      s << matrixValuesNodes(0, it->second.dimensions.size(), it->second.values,
-                             it->second.dimensions, it->second.type);
+      s << matrixValuesNodes(0, it->matrix);
       //         level++;
       //       }
       s << "</values></var>";
@@ -253,47 +249,18 @@ void InterpreterDBG::sendVariables(map<string, Variable> globals,
   sendData(s);
 }
 
-string InterpreterDBG::matrixValuesNodes(unsigned int level, int dimsize,
-                                         map<string, string> &values,
-                                         list<int> &dims, int type,
-                                         string vindex /*= "" */) {
-  list<int>::iterator lsize;
-  unsigned int idx = 0;
-  for (lsize = dims.begin(); lsize != dims.end(); lsize++, idx++) {
-    if (idx == level) {
-      break;
-    }
-  }
-
+string InterpreterDBG::matrixValuesNodes(unsigned int level, Matrix &m,
+                                         int offset /*= 0 */) {
   stringstream s;
-  stringstream vs;
-  for (int i = 0; i < (*lsize); i++) {
-    vs.str("");
-    vs << vindex;
-    if (vindex.length() == 0) {
-      vs << i;
-    } else {
-      vs << ":" << i;
-    }
+  for (int i = 0; i < m.dims()[level]; i++) {
+    int off = offset * m.dims()[level] + i;
 
-    if (level == (dims.size() - 1)) {
-      string val = values[vs.str()];
-      if (val.length() == 0) {
-        switch (type) {
-        case TIPO_INTEIRO:
-        case TIPO_REAL:
-        case TIPO_CARACTERE:
-        case TIPO_LOGICO:
-          val = "0";
-          break;
-        }
-      }
-      s << "<var name=\"" << i << "\" primitive=\"true\" value=\"" << val
-        << "\"/>";
+    if (level == (m.dims().size() - 1)) {
+      s << "<var name=\"" << i << "\" primitive=\"true\" value=\""
+        << m.get(off).toString() << "\"/>";
     } else {
-
       s << "<var name=\"" << i << "\" primitive=\"false\"><values>";
-      s << matrixValuesNodes(level + 1, dimsize, values, dims, type, vs.str());
+      s << matrixValuesNodes(level + 1, m, off);
       s << "</values></var>";
     }
   }
@@ -307,10 +274,8 @@ void InterpreterDBG::sendData(stringstream &s) {
   s.rdbuf()->str("");
   s << str.length() << '\0' << str;
   if (send(clientsock, s.str().c_str(), sizeof(char) * (s.str().length() + 1),
-           0) < 0) { // error
-    if (clientsock > 0) {
-      // cerr << PACKAGE << ": erro ao enviar dados." << endl;
-    } // else, server closed con
+           SEND_FLAGS) < 0) { // error: server closed con
+    closeSock();
   }
 }
 
@@ -477,6 +442,14 @@ bool InterpreterDBG::breakOn(const string &file, int line) {
   return false;
 }
 
+bool InterpreterDBG::isActive() {
+#ifndef WIN32
+  return clientsock >= 0;
+#else
+  return clientsock != INVALID_SOCKET;
+#endif
+}
+
 void InterpreterDBG::closeSock() {
 #ifndef WIN32
   shutdown(clientsock, SHUT_RDWR);
@@ -24,6 +24,7 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef WIN32
 #include <winsock.h>
@@ -33,11 +34,16 @@ using namespace std;
 
 class Variables;
 class Variable;
+class Matrix;
 
+// conexao com o depurador (gpt -d). Cada InterpreterEval tem a sua
 class InterpreterDBG {
 public:
   enum { CMDStepInto, CMDStepOver, CMDStepOut, CMDContinue, CMDNull };
 
+  InterpreterDBG();
+  ~InterpreterDBG();
+
   void init(string host, int port);
 
   void checkData();
@@ -47,19 +53,15 @@ public:
 
   int getCmd();
 
-  static InterpreterDBG *self();
-
   void closeSock();
 
+  bool isActive(); // conectado a um depurador
+
   bool breakOn(const string &file, int line);
 
 private:
-  InterpreterDBG();
-
-  static InterpreterDBG *singleton;
-
   void sendStackInfo(list<pair<string, pair<string, int>>> &stk);
-  void sendVariables(map<string, Variable> globals,
+  void sendVariables(vector<Variable> &vars,
                      list<pair<string, pair<string, int>>> &stk,
                      bool globalScope);
   int receiveCmd(bool nonBlocking = false);
@@ -72,9 +74,7 @@ private:
   void sendData(stringstream &s);
   void removeBreakpoint(string &cmd);
 
-  string matrixValuesNodes(unsigned int level, int dimsize,
-                           map<string, string> &values, list<int> &dims,
-                           int type, string vindex = "");
+  string matrixValuesNodes(unsigned int level, Matrix &m, int offset = 0);
 
 #ifndef WIN32
   int clientsock;
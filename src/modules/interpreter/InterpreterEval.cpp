@@ -26,81 +26,290 @@
 #endif
 #include "GPTDisplay.hpp"
 
-void ExprValue::setValue(string str) { value = str; }
-void ExprValue::setValue(const stringstream &s) { value = s.str(); }
+#include <climits>
+#include <new>
+#include <stdexcept>
+#include <unistd.h>
 
-bool ExprValue::ifTrue() {
-  if (type == TIPO_LITERAL) {
-    return (value.length() > 0) ? true : false;
+const string Literal::emptyString;
+
+Value::Value() : type(TIPO_NULO) { num.i = 0; }
+
+Value::Value(int t) : type(t) {
+  if (type == TIPO_REAL) {
+    num.r = 0;
   } else {
-    return (atof(value.c_str())) ? true : false;
+    num.i = 0;
+  }
+}
+
+void Value::setInteger(int i) {
+  type = TIPO_INTEIRO;
+  num.i = i;
+}
+
+void Value::setReal(float r) {
+  type = TIPO_REAL;
+  num.r = r;
+}
+
+void Value::setChar(int c) {
+  type = TIPO_CARACTERE;
+  num.i = c;
+}
+
+void Value::setBool(bool b) {
+  type = TIPO_LOGICO;
+  num.i = b ? 1 : 0;
+}
+
+void Value::setLiteral(const string &str) {
+  type = TIPO_LITERAL;
+  lit = str;
+}
+
+int Value::toInt() const {
+  switch (type) {
+  case TIPO_REAL:
+    return (int)num.r;
+  case TIPO_LITERAL:
+    return atoi(lit.str().c_str());
+  default:
+    return num.i;
+  }
+}
+
+float Value::toReal() const {
+  switch (type) {
+  case TIPO_REAL:
+    return num.r;
+  case TIPO_LITERAL:
+    return (float)atof(lit.str().c_str());
+  default:
+    return (float)num.i;
+  }
+}
+
+bool Value::ifTrue() const {
+  switch (type) {
+  case TIPO_LITERAL:
+    return !lit.empty();
+  case TIPO_REAL:
+    return num.r != 0;
+  default:
+    return num.i != 0;
+  }
+}
+
+string Value::toString() const {
+  stringstream s;
+  switch (type) {
+  case TIPO_LITERAL:
+    return lit.str();
+  case TIPO_REAL:
+    s << num.r;
+    break;
+  case TIPO_NULO:
+    break;
+  default: // inteiro, caractere (codigo), logico (0/1)
+    s << num.i;
   }
+  return s.str();
 }
 
 //-------------------------------------------------------------------------------
 
-bool Variable::checkBounds(list<string> &d) {
-  list<int>::iterator it = dimensions.begin();
-  list<string>::iterator ot = d.begin();
+Matrix::Matrix() : type(TIPO_NULO), size(0), data(0) {}
+
+Matrix::Matrix(const Matrix &other)
+    : type(other.type), size(other.size), data(other.data) {
+  if (data) {
+    data->refs++;
+  }
+}
+
+Matrix::~Matrix() { release(); }
 
-  int num;
-  for (; it != dimensions.end(); ++it, ++ot) {
-    num = atoi((*ot).c_str());
+Matrix &Matrix::operator=(const Matrix &other) {
+  if (other.data) {
+    other.data->refs++;
+  }
+  release();
+  type = other.type;
+  size = other.size;
+  data = other.data;
+  return *this;
+}
 
-    if ((num < 0) || (num >= (*it))) {
-      return false;
+void Matrix::release() {
+  if (data && (--data->refs == 0)) {
+    delete data;
+  }
+  data = 0;
+}
+
+// garante que os elementos nao sao compartilhados antes de uma escrita
+void Matrix::detach() {
+  if (data->refs > 1) {
+    Data *copy = new Data(*data);
+    copy->refs = 1;
+    data->refs--;
+    data = copy;
+  }
+}
+
+long long Matrix::elements(const list<int> &dims) {
+  long long count = 1;
+  for (list<int>::const_iterator it = dims.begin(); it != dims.end(); ++it) {
+    count *= (*it);
+    if (count > INT_MAX) { // offsets sao int
+      return -1;
+    }
+  }
+  return count;
+}
+
+bool Matrix::init(int t, const list<int> &d) {
+  release();
+
+  long long count = elements(d);
+  if (count < 0) {
+    return false;
+  }
+
+  type = t;
+  size = count;
+  try {
+    data = new Data;
+    data->refs = 1;
+    data->dims.assign(d.begin(), d.end());
+
+    switch (type) {
+    case TIPO_REAL:
+      data->reals.assign(size, 0);
+      break;
+    case TIPO_LITERAL:
+      data->lits.assign(size, Literal());
+      break;
+    default:
+      data->ints.assign(size, 0);
     }
+  } catch (bad_alloc &) {
+    release();
+    size = 0;
+    return false;
+  } catch (length_error &) {
+    release();
+    size = 0;
+    return false;
   }
   return true;
 }
 
-string Variable::getValue(list<string> &d) {
-  stringstream sub;
-  string colon;
-  for (list<string>::iterator it = d.begin(); it != d.end(); ++it) {
-    sub << colon << *it;
-    colon = ":";
+int Matrix::offset(const list<int> &idx) const {
+  long long off = 0;
+  vector<int>::const_iterator dt = data->dims.begin();
+  for (list<int>::const_iterator it = idx.begin(); it != idx.end();
+       ++it, ++dt) {
+    if (((*it) < 0) || ((*it) >= (*dt))) {
+      return -1;
+    }
+    off = off * (*dt) + (*it);
   }
-  return values[sub.str()];
+  return off;
 }
 
-void Variable::setValue(string value) { primitiveValue = castVal(value); }
+Value Matrix::get(int off) const {
+  Value v(type);
+  switch (type) {
+  case TIPO_REAL:
+    v.num.r = data->reals[off];
+    break;
+  case TIPO_LITERAL:
+    v.lit = data->lits[off];
+    break;
+  default:
+    v.num.i = data->ints[off];
+  }
+  return v;
+}
 
-void Variable::setValue(list<string> &d, string value) {
-  stringstream sub;
-  string colon;
-  for (list<string>::iterator it = d.begin(); it != d.end(); ++it) {
-    sub << colon << *it;
-    colon = ":";
+void Matrix::set(int off, const Value &v) {
+  detach();
+  switch (type) {
+  case TIPO_REAL:
+    data->reals[off] = v.num.r;
+    break;
+  case TIPO_LITERAL:
+    data->lits[off] = v.lit;
+    break;
+  default:
+    data->ints[off] = v.num.i;
   }
+}
+
+//-------------------------------------------------------------------------------
 
-  values[sub.str()] = castVal(value);
+void Variable::setValue(const Value &value) { primitiveValue = castVal(value); }
+
+void Variable::setValue(int offset, const Value &value) {
+  matrix.set(offset, castVal(value));
 }
 
-string Variable::castVal(string value) {
-  stringstream ss;
+Value Variable::castVal(const Value &value) {
+  Value ret(type);
   switch (type) {
   case TIPO_INTEIRO:
-    ss << atoi(value.c_str());
-    return ss.str();
+    ret.num.i = value.toInt();
+    break;
+  case TIPO_REAL:
+    ret.num.r = value.toReal();
+    break;
+  case TIPO_CARACTERE:
+    if (value.type == TIPO_LITERAL) {
+      /*************************
+        caractere c := leia();
+
+        se entrar com "1", var.value == 49
+
+        se entrar com "abc"? opces:
+          1: var.value = 0
+            manter uniformidade com por ex:
+              "inteiro i = leia(); //"abc", resultado: i == 0 (interpretado),
+      i=1243249 (compilado/C) 2: var.value = 'a' eh o que acontece em modo
+      compilado/C (scanf(%c))
+      *******************************/
+      ret.num.i = (int)value.lit.str()[0];
+    } else {
+      ret.num.i = value.toInt();
+    }
+    break;
   case TIPO_LOGICO:
-    if ((value.length() == 0) || (value == "falso") || (value == "0")) {
-      return "0";
+    if (value.type == TIPO_LITERAL) {
+      ret.num.i = (value.lit.empty() || (value.lit.str() == "falso") ||
+                   (value.lit.str() == "0"))
+                      ? 0
+                      : 1;
     } else {
-      return "1";
+      ret.num.i = value.ifTrue() ? 1 : 0;
     }
+    break;
+  case TIPO_LITERAL:
+    ret.lit = value.toString();
+    break;
   default:
     return value;
   }
+  return ret;
 }
 
 //------------------------------------------------------------------------
 
-void LValue::addMatrixIndex(ExprValue &e) { dims.push_back(e.value); }
+void LValue::addMatrixIndex(ExprValue &e) { dims.push_back(e.toInt()); }
 
 string LValue::dimsToString() {
   stringstream sub;
-  for (list<string>::iterator it = dims.begin(); it != dims.end(); ++it) {
+  for (list<int>::iterator it = dims.begin(); it != dims.end(); ++it) {
     sub << "[" << *it << "]";
   }
   return sub.str();
@@ -108,616 +317,482 @@ string LValue::dimsToString() {
 
 //------------------------------------------------------------------------
 
-void Variables::init(map<string, Variable> &vars) {
-  currentVars = new map<string, Variable>;
-  *currentVars = vars;
-  globalVars = currentVars;
+void Variables::init(vector<Variable> &vars) {
+  globals.swap(vars);
+  currentVars = globalVars = &globals;
 }
 
-void Variables::pushLocalContext(map<string, Variable> &vars) {
-  varstates.push_back(currentVars);
-  currentVars = new map<string, Variable>;
-  *currentVars = vars;
-}
-
-Variable &Variables::get(const string &name) {
-  stringstream s;
-  if (currentVars->find(name) == currentVars->end()) {
-    if (globalVars->find(name) == globalVars->end()) {
-      stringstream s;
-      s << "BUG: variável " << name << " não encontrada." << endl;
-      GPTDisplay::self()->showError(s);
-      exit(1);
-    } else {
-      return (*globalVars)[name];
-    }
+void Variables::pushLocalContext(const vector<Variable> &frame) {
+  // reaproveita a memoria de chamadas anteriores na mesma profundidade
+  if (depth == (int)frames.size()) {
+    frames.push_back(frame);
   } else {
-    return (*currentVars)[name];
+    frames[depth] = frame;
   }
+  currentVars = &frames[depth++];
 }
 
 void Variables::popContext() {
-  delete currentVars;
-  currentVars = varstates.back();
-  varstates.pop_back();
+  // matrizes recebidas por parametro nao devem continuar compartilhadas com o
+  // chamador (forcaria uma copia na proxima escrita)
+  vector<Variable> &frame = frames[--depth];
+  for (vector<Variable>::iterator it = frame.begin(); it != frame.end(); ++it) {
+    if (!it->isPrimitive) {
+      it->matrix = Matrix();
+    }
+  }
+
+  currentVars = depth ? &frames[depth - 1] : globalVars;
 }
 
-map<string, Variable> &Variables::getLocals() { return *currentVars; }
+vector<Variable> &Variables::getLocals() { return *currentVars; }
 
-map<string, Variable> &Variables::getGlobals() { return *globalVars; }
+vector<Variable> &Variables::getGlobals() { return *globalVars; }
 
 //------------------------------------------------------------------------
 
 InterpreterEval::InterpreterEval(SymbolTable &st, string host, int port)
     : stable(st), dbg_host(host), dbg_port(port), currentLine(-1),
-      currentSkip(false), globalSkip(false) {
+      debugging(false), interactive(isatty(0)), currentSkip(false),
+      globalSkip(false), nextCheck(0), memory(0), statsOut(&cerr),
+      finished(false), debugger(0) {
   skipStack.push(false);
 }
 
-void InterpreterEval::init(const string &file) {
-  list<Symbol> globals = stable.getSymbols(SymbolTable::GlobalScope);
+InterpreterEval::~InterpreterEval() {
+  finish("ok");
+  delete debugger;
+}
 
-  map<string, Variable> vars;
-  for (list<Symbol>::iterator it = globals.begin(); it != globals.end(); ++it) {
+// -1 se a matriz tem mais elementos do que Matrix suporta
+static long long matrixBytes(int type, const list<int> &dims) {
+  long long size = Matrix::elements(dims);
+  if (size < 0) {
+    return -1;
+  }
+  switch (type) {
+  case TIPO_REAL:
+    return size * sizeof(float);
+  case TIPO_LITERAL:
+    return size * sizeof(Literal);
+  default:
+    return size * sizeof(int);
+  }
+}
+
+// monta o estado inicial das variaveis de um escopo, indexado por
+// Symbol::slot. Retorna o total de bytes das matrizes. Se allocate, as
+// matrizes sao alocadas (e a memoria reservada); senao, apenas tipo e
+// dimensoes sao guardados, e o frame serve de modelo para as chamadas
+long long InterpreterEval::buildFrame(list<Symbol> &symbols,
+                                      vector<Variable> &frame, bool allocate) {
+  long long total = 0;
+  for (list<Symbol>::iterator it = symbols.begin(); it != symbols.end(); ++it) {
     if ((*it).isFunction) {
       continue;
     }
-    Variable v;
+
+    if ((int)frame.size() <= (*it).slot) {
+      frame.resize((*it).slot + 1);
+    }
+
+    Variable &v = frame[(*it).slot];
     v.name = (*it).lexeme;
     v.type = (*it).type.primitiveType();
     v.isPrimitive = (*it).type.isPrimitive();
     v.dimensions = (*it).type.dimensions();
+    if (v.isPrimitive) {
+      v.primitiveValue = Value(v.type);
+    } else {
+      long long bytes = matrixBytes(v.type, v.dimensions);
+      if (bytes < 0) { // grande demais: erro em allocMatrix
+        bytes = 0;
+      }
+      if (allocate) {
+        reserveMemory(bytes); // antes de alocar
+        allocMatrix(v);
+      }
+      total += bytes;
+    }
+  }
+  return total;
+}
+
+void InterpreterEval::allocMatrix(Variable &v) {
+  if (Matrix::elements(v.dimensions) < 0) {
+    runtimeError("Matriz \"" + v.name + "\" grande demais");
+  }
+  if (!v.matrix.init(v.type, v.dimensions)) {
+    runtimeError("Memória insuficiente para a matriz \"" + v.name + "\"");
+  }
+}
+
+void InterpreterEval::init(const string &file) {
+  stats.steps = 0;
+  nextCheck = 0; // verifica os limites (e calcula nextCheck) no 1o passo
+  started = chrono::steady_clock::now();
+  if (limits.timeout) {
+    deadline = started + chrono::seconds(limits.timeout);
+  }
+
+  list<Symbol> globals = stable.getSymbols(SymbolTable::GlobalScope);
 
-    if (v.isPrimitive && (v.type != TIPO_LITERAL)) {
-      v.primitiveValue = "0";
+  for (list<Symbol>::iterator it = globals.begin(); it != globals.end(); ++it) {
+    if (!(*it).isFunction) {
+      continue;
+    }
+    if ((int)functions.size() <= (*it).slot) {
+      functions.resize((*it).slot + 1);
+    }
+    Function &f = functions[(*it).slot];
+    f.name = (*it).lexeme;
+    f.type = (*it).type.primitiveType();
+    f.isBuiltin = (*it).isBuiltin;
+    f.params = (*it).param.symbolList().size();
+    f.frameMemory = 0;
+    if (!f.isBuiltin) {
+      list<Symbol> locals = stable.getSymbols(f.name);
+      f.frameMemory = buildFrame(locals, f.frame, false);
+      profiler.addFunction((*it).slot, f.name);
     }
-    vars[v.name] = v;
   }
 
+  vector<Variable> vars;
+  buildFrame(globals, vars, true);
   variables.init(vars);
   context_t ctx = context_t(SymbolTable::GlobalScope, 0);
   stack_entry_t entry = stack_entry_t(file, ctx);
   program_stack.push_back(entry);
 
 #ifndef WIN32
-  InterpreterDBG::self()->init(dbg_host, dbg_port);
+  if (!dbg_host.empty()) {
+    debugger = new InterpreterDBG;
+    debugger->init(dbg_host, dbg_port);
+    debugging = debugger->isActive();
+  }
 #endif
+
+  if (profiler.active()) {
+    profiler.enter(Profiler::MAIN);
+  }
 }
 
 ExprValue InterpreterEval::evaluateOu(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_LOGICO;
-
-  bool l, r;
-  if (left.type == TIPO_LITERAL) {
-    l = (left.value.length() != 0) ? true : false;
-  } else {
-    l = atof(left.value.c_str()) ? true : false;
-  }
-
-  if (right.type == TIPO_LITERAL) {
-    r = (right.value.length() != 0) ? true : false;
-  } else {
-    r = atof(right.value.c_str()) ? true : false;
-  }
-
-  stringstream s;
-  s << (l || r);
-  v.setValue(s);
+  v.setBool(left.ifTrue() || right.ifTrue());
   return v;
 }
 
 ExprValue InterpreterEval::evaluateE(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_LOGICO;
-
-  bool l, r;
-  if (left.type == TIPO_LITERAL) {
-    l = (left.value.length() != 0) ? true : false;
-  } else {
-    l = atof(left.value.c_str()) ? true : false;
-  }
-
-  if (right.type == TIPO_LITERAL) {
-    r = (right.value.length() != 0) ? true : false;
-  } else {
-    r = atof(right.value.c_str()) ? true : false;
-  }
-
-  stringstream s;
-  s << (l && r);
-  v.setValue(s);
+  v.setBool(left.ifTrue() && right.ifTrue());
   return v;
 }
 
 ExprValue InterpreterEval::evaluateBitOu(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_INTEIRO;
-
-  stringstream s;
-  s << (atoi(left.value.c_str()) | atoi(right.value.c_str()));
-  v.setValue(s);
+  v.setInteger(left.toInt() | right.toInt());
   return v;
 }
 
 ExprValue InterpreterEval::evaluateBitXou(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_INTEIRO;
-
-  stringstream s;
-  s << (atoi(left.value.c_str()) ^ atoi(right.value.c_str()));
-  v.setValue(s);
+  v.setInteger(left.toInt() ^ right.toInt());
   return v;
 }
 
 ExprValue InterpreterEval::evaluateBitE(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_INTEIRO;
-
-  stringstream s;
-  s << (atoi(left.value.c_str()) & atoi(right.value.c_str()));
-  v.setValue(s);
+  v.setInteger(left.toInt() & right.toInt());
   return v;
 }
 
 ExprValue InterpreterEval::evaluateIgual(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_LOGICO;
 
-  bool res;
-
-  if ((left.type == TIPO_LITERAL) || (right.type == TIPO_LITERAL)) {
-    res = left.value == right.value;
-  } else {
-    if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-      res = atof(left.value.c_str()) ==
-            atof(right.value.c_str()); //"0" == "0.000"
-    } else {                           // caractere, inteiro, logico
-      res = atoi(left.value.c_str()) == atoi(right.value.c_str());
-    }
+  if ((left.type == TIPO_LITERAL) && (right.type == TIPO_LITERAL)) {
+    v.setBool(left.lit.str() == right.lit.str());
+  } else if ((left.type == TIPO_LITERAL) || (right.type == TIPO_LITERAL)) {
+    v.setBool(left.toString() == right.toString());
+  } else if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
+    v.setBool(left.toReal() == right.toReal());
+  } else { // caractere, inteiro, logico
+    v.setBool(left.num.i == right.num.i);
   }
-
-  stringstream s;
-  s << res;
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateDif(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_LOGICO;
-
-  bool res;
 
-  if ((left.type == TIPO_LITERAL) || (right.type == TIPO_LITERAL)) {
-    res = left.value != right.value;
-  } else {
-    if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-      res = atof(left.value.c_str()) !=
-            atof(right.value.c_str()); //"0" == "0.000"
-    } else {                           // caractere, inteiro, logico
-      res = atoi(left.value.c_str()) != atoi(right.value.c_str());
-    }
+  if ((left.type == TIPO_LITERAL) && (right.type == TIPO_LITERAL)) {
+    v.setBool(left.lit.str() != right.lit.str());
+  } else if ((left.type == TIPO_LITERAL) || (right.type == TIPO_LITERAL)) {
+    v.setBool(left.toString() != right.toString());
+  } else if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
+    v.setBool(left.toReal() != right.toReal());
+  } else { // caractere, inteiro, logico
+    v.setBool(left.num.i != right.num.i);
   }
-
-  stringstream s;
-  s << res;
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateMaior(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_LOGICO;
-
-  bool res;
 
   if ((left.type == TIPO_LITERAL) || (right.type == TIPO_LITERAL)) {
-    res = left.value.length() > right.value.length();
-  } else {
-    if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-      res =
-          atof(left.value.c_str()) > atof(right.value.c_str()); //"0" == "0.000"
-    } else { // caractere, inteiro, logico
-      res = atoi(left.value.c_str()) > atoi(right.value.c_str());
-    }
+    v.setBool(left.toString().length() > right.toString().length());
+  } else if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
+    v.setBool(left.toReal() > right.toReal());
+  } else { // caractere, inteiro, logico
+    v.setBool(left.num.i > right.num.i);
   }
-
-  stringstream s;
-  s << res;
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateMaiorEq(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_LOGICO;
-
-  bool res;
 
   if ((left.type == TIPO_LITERAL) || (right.type == TIPO_LITERAL)) {
-    res = left.value.length() >= right.value.length();
-  } else {
-    if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-      res = atof(left.value.c_str()) >=
-            atof(right.value.c_str()); //"0" == "0.000"
-    } else {                           // caractere, inteiro, logico
-      res = atoi(left.value.c_str()) >= atoi(right.value.c_str());
-    }
+    v.setBool(left.toString().length() >= right.toString().length());
+  } else if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
+    v.setBool(left.toReal() >= right.toReal());
+  } else { // caractere, inteiro, logico
+    v.setBool(left.num.i >= right.num.i);
   }
-
-  stringstream s;
-  s << res;
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateMenor(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_LOGICO;
-
-  bool res;
 
   if ((left.type == TIPO_LITERAL) || (right.type == TIPO_LITERAL)) {
-    res = left.value.length() < right.value.length();
-  } else {
-    if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-      res =
-          atof(left.value.c_str()) < atof(right.value.c_str()); //"0" == "0.000"
-    } else { // caractere, inteiro, logico
-      res = atoi(left.value.c_str()) < atoi(right.value.c_str());
-    }
+    v.setBool(left.toString().length() < right.toString().length());
+  } else if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
+    v.setBool(left.toReal() < right.toReal());
+  } else { // caractere, inteiro, logico
+    v.setBool(left.num.i < right.num.i);
   }
-
-  stringstream s;
-  s << res;
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateMenorEq(ExprValue &left, ExprValue &right) {
   ExprValue v;
-  v.type = TIPO_LOGICO;
-
-  bool res;
 
   if ((left.type == TIPO_LITERAL) || (right.type == TIPO_LITERAL)) {
-    res = left.value.length() <= right.value.length();
-  } else {
-    if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-      res = atof(left.value.c_str()) <=
-            atof(right.value.c_str()); //"0" == "0.000"
-    } else {                           // caractere, inteiro, logico
-      res = atoi(left.value.c_str()) <= atoi(right.value.c_str());
-    }
+    v.setBool(left.toString().length() <= right.toString().length());
+  } else if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
+    v.setBool(left.toReal() <= right.toReal());
+  } else { // caractere, inteiro, logico
+    v.setBool(left.num.i <= right.num.i);
   }
-
-  stringstream s;
-  s << res;
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateMais(ExprValue &left, ExprValue &right) {
   ExprValue v;
-
-  stringstream s;
   if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-    s << (atof(left.value.c_str()) + atof(right.value.c_str()));
-    v.type = TIPO_REAL;
+    v.setReal(left.toReal() + right.toReal());
   } else {
-    s << (atoi(left.value.c_str()) + atoi(right.value.c_str()));
-    v.type = TIPO_INTEIRO;
+    v.setInteger(left.toInt() + right.toInt());
   }
-
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateMenos(ExprValue &left, ExprValue &right) {
   ExprValue v;
-
-  stringstream s;
   if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-    s << (atof(left.value.c_str()) - atof(right.value.c_str()));
-    v.type = TIPO_REAL;
+    v.setReal(left.toReal() - right.toReal());
   } else {
-    s << (atoi(left.value.c_str()) - atoi(right.value.c_str()));
-    v.type = TIPO_INTEIRO;
+    v.setInteger(left.toInt() - right.toInt());
   }
-
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateDiv(ExprValue &left, ExprValue &right) {
   ExprValue v;
 
-  if (atof(right.value.c_str()) == 0) {
-    stringstream s;
-    s << PACKAGE << ": Erro de execução próximo a linha " << currentLine
-      << " - Divisão por 0 é ilegal. Abortando..." << endl;
-    GPTDisplay::self()->showError(s);
-    exit(1);
+  if (right.toReal() == 0) {
+    runtimeError("Divisão por 0 é ilegal");
   }
 
-  stringstream s;
   if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-    s << (atof(left.value.c_str()) / atof(right.value.c_str()));
-    v.type = TIPO_REAL;
+    v.setReal(left.toReal() / right.toReal());
   } else {
-    s << (atoi(left.value.c_str()) / atoi(right.value.c_str()));
-    v.type = TIPO_INTEIRO;
+    // INT_MIN / -1 gera SIGFPE; o resultado com complemento de 2 e' INT_MIN
+    int r = right.toInt();
+    if (r == -1) {
+      v.setInteger((int)(0u - (unsigned)left.toInt()));
+    } else {
+      v.setInteger(left.toInt() / r);
+    }
   }
-
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateMultip(ExprValue &left, ExprValue &right) {
   ExprValue v;
-
-  stringstream s;
   if ((left.type == TIPO_REAL) || (right.type == TIPO_REAL)) {
-    s << (atof(left.value.c_str()) * atof(right.value.c_str()));
-    v.type = TIPO_REAL;
+    v.setReal(left.toReal() * right.toReal());
   } else {
-    s << (atoi(left.value.c_str()) * atoi(right.value.c_str()));
-    v.type = TIPO_INTEIRO;
+    v.setInteger(left.toInt() * right.toInt());
   }
-
-  v.setValue(s);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateMod(ExprValue &left, ExprValue &right) {
   ExprValue v;
+  int r = right.toInt();
 
-  stringstream s;
-
-  s << (atoi(left.value.c_str()) % atoi(right.value.c_str()));
-  v.type = TIPO_INTEIRO;
+  if (r == 0) {
+    runtimeError("Divisão por 0 é ilegal");
+  }
 
-  v.setValue(s);
+  // idem para INT_MIN % -1; o resto por -1 e' sempre 0
+  v.setInteger((r == -1) ? 0 : left.toInt() % r);
   return v;
 }
 
 ExprValue InterpreterEval::evaluateUnNeg(ExprValue &v) {
-  stringstream s;
-  s << -(atof(v.value.c_str()));
-
-  v.setValue(s);
+  if (v.type == TIPO_REAL) {
+    v.num.r = -v.num.r;
+  } else {
+    v.num.i = -v.num.i;
+  }
   return v;
 }
 
-ExprValue InterpreterEval::evaluateUnPos(ExprValue &v) {
-  stringstream s;
-  s << +(atof(v.value.c_str()));
-  v.setValue(s);
-  return v;
-}
+ExprValue InterpreterEval::evaluateUnPos(ExprValue &v) { return v; }
 
 ExprValue InterpreterEval::evaluateUnNot(ExprValue &v) {
-  v.type = TIPO_LOGICO;
-
-  if (v.type == TIPO_LITERAL) {
-    v.value = (v.value.length() > 0) ? "0" : "1";
-  } else {
-    v.value = atof(v.value.c_str()) ? "0" : "1";
-  }
-
+  v.setBool(!v.ifTrue());
   return v;
 }
 
 ExprValue InterpreterEval::evaluateUnBNot(ExprValue &v) {
-  stringstream s;
-  s << ~(atoi(v.value.c_str()));
-  v.setValue(s);
+  v.num.i = ~v.toInt();
   return v;
 }
 
 ExprValue InterpreterEval::getLValueValue(LValue &l) {
   ExprValue value;
 
-  Variable var = variables.get(l.name);
-  value.type = var.type;
+  Variable &var = variables.get(l);
   if (var.isPrimitive) {
-    value.value = var.primitiveValue;
+    value = var.primitiveValue;
   } else {
     if (l.dims.size()) { // if mat[x][x][x]...
-      if (var.checkBounds(l.dims)) {
-        value.value = var.getValue(l.dims);
-        //         value.values = var.values;
-      } else {
-        stringstream s;
-        s << PACKAGE << ": Erro de execução próximo a linha " << currentLine
-          << " - Overflow em \"" << l.name << l.dimsToString()
-          << "\". Abortando..." << endl;
-        GPTDisplay::self()->showError(s);
-        exit(1);
-      }
+      value = var.matrix.get(matrixOffset(var, l));
+      stats.matrixReads++;
     } else { // if func(mat)
-      value.values = var.values;
+      value.matrix = var.matrix;
     }
   }
+  value.type = var.type;
   return value;
 }
 
-void InterpreterEval::execPasso(LValue &lvalue, int passo) {
-  // 1: get the symbol
-  // 3: set the v.value to the variable in the current scope
-  Variable &var = variables.get(lvalue.name);
-
-  stringstream s;
-  if (var.isPrimitive) {
-    s << (atoi(var.primitiveValue.c_str()) + passo);
-    var.primitiveValue = s.str();
-  } else {
-    if (var.checkBounds(lvalue.dims)) {
-      string val = var.getValue(lvalue.dims);
-      s << (atoi(val.c_str()) + passo);
-      var.setValue(lvalue.dims, s.str());
-    } else {
-      stringstream err;
-      err << PACKAGE << ": Erro de execução próximo a linha " << currentLine
-          << " - Overflow em \"" << lvalue.name << lvalue.dimsToString()
-          << "\". Abortando..." << endl;
-      GPTDisplay::self()->showError(err);
-      exit(1);
-    }
-  }
-}
-
-bool InterpreterEval::execLowerEq(LValue &lv, ExprValue &ate) {
-  Variable var = variables.get(lv.name);
+int &InterpreterEval::counter(LValue &lv) {
+  Variable &var = variables.get(lv);
 
   if (var.isPrimitive) {
-    return atoi(var.primitiveValue.c_str()) <= atoi(ate.value.c_str());
+    return var.primitiveValue.num.i;
   } else {
-    if (var.checkBounds(lv.dims)) {
-      string val = var.getValue(lv.dims);
-      return atoi(val.c_str()) <= atoi(ate.value.c_str());
-    } else {
-      stringstream s;
-      s << PACKAGE << ": Erro de execução próximo a linha " << currentLine
-        << " - Overflow em \"" << lv.name << lv.dimsToString()
-        << "\". Abortando..." << endl;
-      GPTDisplay::self()->showError(s);
-      exit(1);
-    }
-  }
-}
-
-bool InterpreterEval::execBiggerEq(LValue &lv, ExprValue &ate) {
-  Variable var = variables.get(lv.name);
-
-  if (var.isPrimitive) {
-    return atoi(var.primitiveValue.c_str()) >= atoi(ate.value.c_str());
-  } else {
-    if (var.checkBounds(lv.dims)) {
-      string val = var.getValue(lv.dims);
-      return atoi(val.c_str()) <= atoi(ate.value.c_str());
-    } else {
-      stringstream s;
-      s << PACKAGE << ": Erro de execução próximo a linha " << currentLine
-        << " - Overflow em \"" << lv.name << lv.dimsToString()
-        << "\". Abortando..." << endl;
-      GPTDisplay::self()->showError(s);
-      exit(1);
-    }
+    return var.matrix.intRef(matrixOffset(var, lv));
   }
 }
 
 void InterpreterEval::execAttribution(LValue &lvalue, ExprValue &v) {
-  Variable &var = variables.get(lvalue.name);
+  Variable &var = variables.get(lvalue);
 
   if (var.isPrimitive) {
-    var.setValue(castLeiaChar(var, v));
+    var.setValue(v);
   } else {
-    if (var.checkBounds(lvalue.dims)) {
-      var.setValue(lvalue.dims, v.value);
-    } else {
-      stringstream s;
-      s << PACKAGE << ": Erro de execução próximo a linha " << currentLine
-        << " - Overflow em \"" << lvalue.name << lvalue.dimsToString()
-        << "\". Abortando..." << endl;
-      GPTDisplay::self()->showError(s);
-      exit(1);
-    }
+    var.setValue(matrixOffset(var, lvalue), v);
+    stats.matrixWrites++;
   }
 }
 
-string InterpreterEval::castLeiaChar(Variable &var, ExprValue &v) {
-  if ((var.type == TIPO_CARACTERE) && (v.type == TIPO_LITERAL)) {
-
-    /*************************
-      caractere c := leia();
-
-      se entrar com "1", var.value == 49
-
-      se entrar com "abc"? opces:
-        1: var.value = 0
-          manter uniformidade com por ex:
-            "inteiro i = leia(); //"abc", resultado: i == 0 (interpretado),
-    i=1243249 (compilado/C) 2: var.value = 'a' eh o que acontece em modo
-    compilado/C (scanf(%c))
-    *******************************/
+void InterpreterEval::beginFunctionCall(const string &file, int func,
+                                        list<ExprValue> &args, int line) {
+  argsBuffer.assign(args.begin(), args.end());
+  beginFunctionCall(file, func, argsBuffer.empty() ? 0 : &argsBuffer[0], line);
+  argsBuffer.clear();
+}
 
-    /*    if(v.value.length() > 1) {
-          return "0";
-        }*/
+void InterpreterEval::beginFunctionCall(const string &file, int func,
+                                        ExprValue *args, int line) {
+  Function &f = functions[func];
 
+  if (variables.getDepth() >= limits.maxDepth) {
     stringstream s;
-    s << (int)v.value[0];
-    return s.str();
-  } else {
-    return v.value;
+    s << "Limite de " << limits.maxDepth
+      << " chamadas de função aninhadas excedido";
+    limitExceeded(s.str());
   }
-}
-
-void InterpreterEval::beginFunctionCall(const string &file,
-                                        const string &funcname,
-                                        list<ExprValue> &args, int line) {
-  // setup local vars
-
-  list<Symbol> globals = stable.getSymbols(funcname);
-
-  map<string, Variable> vars;
-  for (list<Symbol>::iterator it = globals.begin(); it != globals.end(); ++it) {
-    Variable v;
-    v.name = (*it).lexeme;
-    v.type = (*it).type.primitiveType();
-    v.isPrimitive = (*it).type.isPrimitive();
-    v.dimensions = (*it).type.dimensions();
 
-    if (v.isPrimitive && (v.type != TIPO_LITERAL)) {
-      v.primitiveValue = "0";
-    }
+  // reserva todas as matrizes do frame, inclusive as recebidas por
+  // parametro, que sao copiadas na primeira escrita (pior caso)
+  reserveMemory(f.frameMemory);
+  frameMem.push_back(f.frameMemory);
 
-    vars[v.name] = v;
+  if (profiler.active()) {
+    profiler.enter(func);
   }
-  variables.pushLocalContext(vars);
 
-  // init params
-  Symbol func = stable.getSymbol(SymbolTable::GlobalScope, funcname);
-  list<pair<string, SymbolType>> &params = func.param.symbolList();
+  variables.pushLocalContext(f.frame);
 
-  list<pair<string, SymbolType>>::iterator pit = params.begin();
-  list<ExprValue>::iterator ait = args.begin();
+  stats.calls++;
+  if (variables.getDepth() > stats.maxDepth) {
+    stats.maxDepth = variables.getDepth();
+  }
 
-  while ((ait != args.end()) && (pit != params.end())) {
-    Symbol pv = stable.getSymbol(funcname, (*pit).first);
-    Variable &var = variables.get(pv.lexeme);
+  // init params (declarados primeiro no escopo da funcao: slots 0..n-1)
+  for (int slot = 0; slot < f.params; slot++) {
+    Variable &var = variables.getLocal(slot);
     if (var.isPrimitive) {
-      var.primitiveValue = (*ait).value;
+      var.setValue(args[slot]);
     } else {
-      var.values = (*ait).values;
+      var.matrix = args[slot].matrix;
     }
+  }
 
-    ++ait;
-    ++pit;
+  // matrizes locais: o modelo (f.frame) so tem tipo e dimensoes
+  for (int slot = f.params; slot < (int)f.frame.size(); slot++) {
+    Variable &var = variables.getLocal(slot);
+    if (!var.isPrimitive) {
+      allocMatrix(var);
+    }
   }
 
-  context_t ctx = context_t(funcname, line);
-  stack_entry_t entry = stack_entry_t(file, ctx);
-  program_stack.push_back(entry);
+  if (debugging) {
+    context_t ctx = context_t(f.name, line);
+    stack_entry_t entry = stack_entry_t(file, ctx);
+    program_stack.push_back(entry);
 
-  skipStack.push(currentSkip);
+    skipStack.push(currentSkip);
+  }
 }
 
 void InterpreterEval::endFunctionCall() {
   variables.popContext();
-  program_stack.pop_back();
+  memory -= frameMem.back();
+  frameMem.pop_back();
 
-  skipStack.pop();
-}
+  if (profiler.active()) {
+    profiler.leave();
+  }
+
+  if (debugging) {
+    program_stack.pop_back();
 
-bool InterpreterEval::isBuiltInFunction(const string &fname) {
-  return stable.getSymbol(SymbolTable::GlobalScope, fname).isBuiltin;
+    skipStack.pop();
+  }
 }
 
-ExprValue InterpreterEval::execBuiltInFunction(const string &fname,
+ExprValue InterpreterEval::execBuiltInFunction(int func,
                                                list<ExprValue> &args) {
+  const string &fname = functions[func].name;
   ExprValue v;
   if (fname == "leia") {
     return executeLeia();
@@ -728,39 +803,37 @@ ExprValue InterpreterEval::execBuiltInFunction(const string &fname,
     stringstream s;
     s << PACKAGE << ":BUG: No built-in function called \"" << fname << "\""
       << endl;
-    GPTDisplay::self()->showError(s);
+    GPTDisplay::showError(s);
     return v;
   }
 }
 
 void InterpreterEval::setReturnExprValue(ExprValue &v) { retExpr = v; }
 
-ExprValue InterpreterEval::getReturnExprValue(const string &fname) {
-  Symbol func = stable.getSymbol(SymbolTable::GlobalScope, fname);
-
-  if ((func.type.primitiveType() != TIPO_REAL) && (retExpr.type == TIPO_REAL)) {
-    // trunca o valor inteiro
-    stringstream s;
-    s << atoi(retExpr.value.c_str());
-    retExpr.setValue(s);
-  }
-
-  retExpr.type = func.type.primitiveType();
+ExprValue InterpreterEval::getReturnExprValue(int func) {
+  // converte para o tipo da funcao (trunca valores reais)
+  Variable ret;
+  ret.type = functions[func].type;
+  retExpr = ret.castVal(retExpr);
   return retExpr;
 }
 
-int InterpreterEval::getReturning() { return atoi(retExpr.value.c_str()); }
+int InterpreterEval::getReturning() { return retExpr.toInt(); }
 
 //----------- Debugger -------------------------
 
-void InterpreterEval::nextCmd(const string &file, int line) {
+void InterpreterEval::debugCmd(const string &file, int line) {
+#ifndef WIN32
+  if (!debugger->isActive()) { // conexao encerrada
+    debugging = false;
+    return;
+  }
+
   program_stack.back().second.second = line;
 
-  currentLine = line;
-#ifndef WIN32
-  InterpreterDBG::self()->checkData();
+  debugger->checkData();
 
-  if (InterpreterDBG::self()->breakOn(file, line)) {
+  if (debugger->breakOn(file, line)) {
     // goto no-skip state
     skipStack.pop();
     skipStack.push(false);
@@ -771,8 +844,8 @@ void InterpreterEval::nextCmd(const string &file, int line) {
     stringstream s;
     int cmd;
 
-    InterpreterDBG::self()->sendInfo(currentLine, variables, program_stack);
-    cmd = InterpreterDBG::self()->getCmd();
+    debugger->sendInfo(currentLine, variables, program_stack);
+    cmd = debugger->getCmd();
     switch (cmd) {
     case InterpreterDBG::CMDStepInto:
       currentSkip = false;
@@ -792,7 +865,7 @@ void InterpreterEval::nextCmd(const string &file, int line) {
       break;
     default:
       s << PACKAGE << ": BUG: unknown cmd." << endl;
-      GPTDisplay::self()->showError(s);
+      GPTDisplay::showError(s);
       break;
     }
   }
@@ -801,57 +874,205 @@ void InterpreterEval::nextCmd(const string &file, int line) {
 
 // private
 
-ExprValue InterpreterEval::executeLeia() {
+int InterpreterEval::matrixOffset(Variable &var, LValue &l) {
+  stats.boundsChecks += l.dims.size();
+  int off = var.matrix.offset(l.dims);
+  if (off < 0) {
+    runtimeError("Overflow em \"" + l.name + l.dimsToString() + "\"");
+  }
+  return off;
+}
+
+void InterpreterEval::runtimeError(const string &msg) {
+  stringstream s;
+  s << PACKAGE << ": Erro de execução";
+  if (currentLine >= 0) { // erros antes do 1o comando, como em init()
+    s << " próximo a linha " << currentLine;
+  }
+  s << " - " << msg << ". Abortando...";
+  finish("erro");
+  throw ExecutionError("erro", EXIT_FAILURE, s.str());
+}
+
+// como runtimeError, mas com codigo de saida proprio, para que quem executa
+// o programa distinga um limite excedido de um erro do algoritmo
+void InterpreterEval::limitExceeded(const string &msg) {
+  stringstream s;
+  s << PACKAGE << ": Execução interrompida";
+  if (currentLine >= 0) {
+    s << " próximo a linha " << currentLine;
+  }
+  s << " - " << msg << ". Abortando...";
+  finish("limite");
+  throw ExecutionError("limite", ExecutionLimits::EXIT_CODE, s.str());
+}
+
+void InterpreterEval::finish(const string &result) {
+  if (finished) {
+    return;
+  }
+  finished = true;
+
+  profiler.write();
+  output.flush();
+  stats.leiaBytes = input.bytesRead();
+  stats.imprimaBytes = output.bytesWritten();
+  stats.phases.push_back(make_pair(
+      string("execucao"),
+      chrono::duration<double>(chrono::steady_clock::now() - started)
+          .count()));
+  if (stats.enabled) {
+    stats.write(*statsOut, result);
+  }
+}
+
+void InterpreterEval::checkLimits() {
+  if (limits.maxSteps && (stats.steps > limits.maxSteps)) {
+    stringstream s;
+    s << "Limite de " << limits.maxSteps << " passos de execução excedido";
+    limitExceeded(s.str());
+  }
+
+  if (limits.timeout && (chrono::steady_clock::now() >= deadline)) {
+    stringstream s;
+    s << "Tempo limite de " << limits.timeout << " segundos excedido";
+    limitExceeded(s.str());
+  }
+
+  // sem limites de passos e tempo, step() nao volta a chamar checkLimits
+  nextCheck = LLONG_MAX;
+  if (limits.timeout) {
+    nextCheck = stats.steps + CHECK_INTERVAL;
+  }
+  if (limits.maxSteps && (limits.maxSteps < nextCheck)) {
+    nextCheck = limits.maxSteps + 1;
+  }
+}
+
+void InterpreterEval::reserveMemory(long long bytes) {
+  memory += bytes;
+  if (memory > stats.peakMemory) {
+    stats.peakMemory = memory;
+  }
+  if (limits.maxMemory && (memory > limits.maxMemory)) {
+    stringstream s;
+    s << "Limite de " << limits.maxMemory / (1024 * 1024)
+      << " MB de memória excedido";
+    limitExceeded(s.str());
+  }
+}
+
+ExprValue InterpreterEval::executeLeia(int type) {
+  stats.leiaCalls++;
+
+  if (interactive) { // exibe o que foi impresso antes de esperar o usuario
+    output.flush();
+  }
+
+  // o tipo de destino, quando conhecido, evita a conversao via literal
   ExprValue ret;
-  ret.type = TIPO_LITERAL;
-  //   cin >> ret.value;
-  std::getline(cin, ret.value);
-  //   ret.value.getline();
+  switch (type) {
+  case TIPO_INTEIRO:
+    ret.setInteger(input.readInt());
+    break;
+  case TIPO_REAL:
+    ret.setReal(input.readReal());
+    break;
+  case TIPO_CARACTERE:
+    ret.setChar(input.readChar());
+    break;
+  default:
+    string line;
+    input.readLine(line);
+    ret.setLiteral(line);
+  }
   return ret;
 }
 
 void InterpreterEval::executeImprima(list<ExprValue> &args) {
-  ios_base::fmtflags old = cout.flags(ios_base::fixed);
-  int oldp = cout.precision(2);
+  static const string verdadeiro = "verdadeiro";
+  static const string falso = "falso";
+  static const string nulo = "(nulo)";
+
+  stats.imprimaCalls++;
 
-  stringstream s;
   for (list<ExprValue>::iterator it = args.begin(); it != args.end(); ++it) {
-    ExprValue ss = (*it);
     switch ((*it).type) {
     case TIPO_INTEIRO:
-      cout << (int)atoi((*it).value.c_str());
+      output.putInt((*it).num.i);
       break;
     case TIPO_REAL:
-      cout << (float)atof((*it).value.c_str());
+      output.putReal((*it).num.r);
       break;
     case TIPO_CARACTERE:
-      cout << (char)atoi((*it).value.c_str());
+      output.putChar((char)(*it).num.i);
       break;
     case TIPO_LOGICO:
-      if (atoi((*it).value.c_str())) {
-        cout << "verdadeiro";
-      } else {
-        cout << "falso";
-      }
+      output.putString((*it).num.i ? verdadeiro : falso);
       break;
     case TIPO_LITERAL:
-      if (!(*it).value.empty()) {
-        cout << (*it).value.c_str();
-      } else {
-        cout << "(nulo)";
-      }
+      output.putString((*it).lit.empty() ? nulo : (*it).lit.str());
       break;
     default:
-      cout << (*it).value;
+      output.putString((*it).toString());
     }
   }
-  cout << endl;
-  cout.flush();
+  output.endLine();
+}
 
-  cout.flags(old);
-  cout.precision(oldp);
+string InterpreterEval::parseLiteral(string str) {
+  string::size_type idx = 0;
+  char c;
+  while ((idx = str.find('\\', idx)) != string::npos) {
+    switch (str[idx + 1]) {
+    case 'n':
+      c = '\n';
+      break;
+    case 't':
+      c = '\t';
+      break;
+    case 'r':
+      c = '\r';
+      break;
+    case '\\':
+      c = '\\';
+      break;
+    case '\'':
+      c = '\'';
+      break;
+    case '"':
+      c = '"';
+      break;
+    default:
+      c = str[idx + 1];
+    }
+    str.replace(idx, 2, 1, c);
+    idx++;
+  }
+  return str;
 }
 
-// void InterpreterEval::parseLiteral(string& lit) {
-//
-// }
+int InterpreterEval::parseChar(const string &str) {
+  /*
+    ''    => 0
+    'a'   => a
+    '\t'  => \t
+    '\n'  => \n
+    '\r'  => \r
+    '\i'  => i
+  */
+  if (str[0] == '\\') {
+    switch (str[1]) {
+    case 't':
+      return (int)'\t';
+    case 'n':
+      return (int)'\n';
+    case 'r':
+      return (int)'\r';
+    default:
+      return (int)str[1];
+    }
+  } else {
+    return (int)str[0];
+  }
+}
@@ -21,49 +21,142 @@
 #ifndef INTERPRETERHELPER_HPP
 #define INTERPRETERHELPER_HPP
 
+#include "ExecutionError.hpp"
+#include "ExecutionLimits.hpp"
+#include "InputBuffer.hpp"
+#include "OutputBuffer.hpp"
+#include "Profiler.hpp"
+#include "RuntimeStats.hpp"
 #include "Symbol.hpp"
 #include "SymbolTable.hpp"
 
+#include <chrono>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <stack>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 using namespace std;
 
-class ExprValue {
+class InterpreterDBG;
+
+// texto imutavel de um literal. Copias compartilham o mesmo armazenamento,
+// de modo que constantes decodificadas uma unica vez podem ser empilhadas,
+// atribuidas e impressas sem copiar a string.
+class Literal {
+public:
+  Literal() {}
+  Literal(const string &str)
+      : text(str.empty() ? nullptr : make_shared<const string>(str)) {}
+
+  const string &str() const { return text ? *text : emptyString; }
+  bool empty() const { return !text || text->empty(); }
+
+private:
+  shared_ptr<const string> text;
+  static const string emptyString;
+};
+
+// valor primitivo tipado (inteiro, real, caractere, logico ou literal)
+class Value {
 public:
-  void setValue(string str);
-  void setValue(const stringstream &s);
-  bool ifTrue();
+  Value();
+  explicit Value(int type);
+
+  void setInteger(int i);
+  void setReal(float r);
+  void setChar(int c);
+  void setBool(bool b);
+  void setLiteral(const string &str);
+
+  int toInt() const;
+  float toReal() const;
+  bool ifTrue() const;
+
+  string toString() const;
 
-  string value;
-  map<string, string>
-      values; // map<keys, value>. ex: matrix["10:1"] == matrix[10][1]
   int type;
+  union {
+    int i; // inteiro, caractere, logico
+    float r;
+  } num;
+  Literal lit; // literal
 };
 
-class Variable {
+// matriz armazenada de forma contigua (row-major), tipada.
+// Copias compartilham os elementos ate que uma delas seja alterada
+// (copy-on-write), o que torna barata a passagem de matrizes por valor.
+class Matrix {
+public:
+  Matrix();
+  Matrix(const Matrix &other);
+  ~Matrix();
+
+  Matrix &operator=(const Matrix &other);
+
+  // false se os elementos nao cabem em int ou na memoria
+  bool init(int type, const list<int> &dims);
+
+  // numero de elementos; -1 se nao cabe em int
+  static long long elements(const list<int> &dims);
+
+  int offset(const list<int> &idx) const; // -1 se fora dos limites
+
+  const vector<int> &dims() const { return data->dims; }
+
+  Value get(int offset) const;
+  void set(int offset, const Value &v);
+
+  int getInt(int offset) const { return data->ints[offset]; }
+  int &intRef(int offset) { // para escrita
+    detach();
+    return data->ints[offset];
+  }
+
+  int type;
+  int size;
+
+private:
+  struct Data {
+    int refs;
+    vector<int> dims;
+    vector<int> ints; // inteiro, caractere, logico
+    vector<float> reals;
+    vector<Literal> lits;
+  };
+
+  void detach();
+  void release();
+
+  Data *data;
+};
+
+class ExprValue : public Value {
 public:
-  bool checkBounds(list<string> &d);
+  ExprValue() {}
+  ExprValue(const Value &v) : Value(v) {}
 
-  string getValue(list<string> &d);
+  Matrix matrix; // func(mat)
+};
 
-  void setValue(string value);
-  void setValue(list<string> &d, string value);
-  string castVal(string value);
+class Variable {
+public:
+  void setValue(const Value &value);
+  void setValue(int offset, const Value &value);
+  Value castVal(const Value &value);
 
   string name;
   int type;
 
   bool isPrimitive;
-  string primitiveValue;
+  Value primitiveValue;
 
-  map<string, string>
-      values;           // map<keys, value>. ex: matrix["10:1"] == matrix[10][1]
+  Matrix matrix;
   list<int> dimensions; // dim configuration
 };
 
@@ -73,30 +166,52 @@ public:
   string dimsToString();
 
   string name;
-  list<string> dims; // 0,2,3 == X[0][2][3]
+  bool global; // escopo/posicao resolvidos na analise semantica
+  int slot;
+  list<int> dims; // 0,2,3 == X[0][2][3]
 };
 
 class Variables {
 public:
-  void init(map<string, Variable> &);
+  Variables() : depth(0) {}
+
+  void init(vector<Variable> &);
+
+  void pushLocalContext(const vector<Variable> &frame);
 
-  void pushLocalContext(map<string, Variable> &);
-  void add(Variable &v);
+  Variable &get(LValue &l) {
+    return l.global ? (*globalVars)[l.slot] : (*currentVars)[l.slot];
+  }
+  Variable &getLocal(int slot) { return (*currentVars)[slot]; }
+  Variable &getGlobal(int slot) { return (*globalVars)[slot]; }
 
-  Variable &get(const string &name);
+  int getDepth() const { return depth; }
 
   void popContext();
 
-  map<string, Variable> &getLocals();
+  vector<Variable> &getLocals();
 
-  map<string, Variable> &getGlobals();
+  vector<Variable> &getGlobals();
 
 private:
-  typedef map<string, Variable> VariableState_t;
+  vector<Variable> globals;
+  vector<vector<Variable>> frames; // registros de ativacao (reaproveitados)
+  int depth;                       // frames em uso
 
-  list<VariableState_t *> varstates;
-  map<string, Variable> *currentVars; // map<varname, Variable>
-  map<string, Variable> *globalVars;
+  vector<Variable> *currentVars; // indexado pela posicao (Symbol::slot)
+  vector<Variable> *globalVars;
+};
+
+// funcao resolvida uma unica vez, indexada por Symbol::slot
+class Function {
+public:
+  string name;
+  int type; // tipo de retorno
+  bool isBuiltin;
+  int params;
+
+  vector<Variable> frame; // variaveis locais (matrizes nao alocadas)
+  long long frameMemory;  // bytes das matrizes de frame
 };
 
 //------------------------------------------------------------------------
@@ -104,9 +219,34 @@ private:
 class InterpreterEval {
 public:
   InterpreterEval(SymbolTable &st, string host, int port);
+  ~InterpreterEval();
 
   void init(const string &);
 
+  void setLimits(const ExecutionLimits &l) { limits = l; }
+  bool setProfile(const string &file) { return profiler.open(file); }
+
+  // phases: tempo das fases anteriores a execucao (analise, compilacao...)
+  void enableStats(const vector<pair<string, double>> &phases,
+                   ostream &out = cerr) {
+    stats.enabled = true;
+    stats.phases = phases;
+    statsOut = &out;
+  }
+
+  // le e escreve nos streams em vez da entrada e saida padrao
+  void setStreams(istream &in, ostream &out) {
+    input.setStream(in);
+    output.setStream(out);
+    interactive = false;
+  }
+
+  // grava perfil e estatisticas (uma unica vez). Chamada ao abortar a
+  // execucao e pelo destrutor
+  void finish(const string &result);
+
+  RuntimeStats stats; // tambem incrementados pela VirtualMachine
+
   ExprValue evaluateOu(ExprValue &left, ExprValue &right);
   ExprValue evaluateE(ExprValue &left, ExprValue &right);
   ExprValue evaluateBitOu(ExprValue &left, ExprValue &right);
@@ -130,46 +270,104 @@ public:
 
   ExprValue getLValueValue(LValue &l);
 
-  void execPasso(LValue &lvalue, int passo);
-  bool execLowerEq(LValue &lv, ExprValue &ate);
-  bool execBiggerEq(LValue &lv, ExprValue &ate);
+  int &counter(LValue &lv); // variavel de controle de um "para"
 
   void execAttribution(LValue &lvalue, ExprValue &v);
 
-  void beginFunctionCall(const string &file, const string &fname,
-                         list<ExprValue> &args, int line);
+  void beginFunctionCall(const string &file, int func, ExprValue *args,
+                         int line);
+  void beginFunctionCall(const string &file, int func, list<ExprValue> &args,
+                         int line);
   void endFunctionCall();
 
-  bool isBuiltInFunction(const string &fname);
-  ExprValue execBuiltInFunction(const string &fname, list<ExprValue> &args);
+  bool isBuiltInFunction(int func) { return functions[func].isBuiltin; }
+  ExprValue execBuiltInFunction(int func, list<ExprValue> &args);
 
   void setReturnExprValue(ExprValue &v);
-  ExprValue getReturnExprValue(const string &);
+  ExprValue getReturnExprValue(int func);
 
   int getReturning();
 
+  Variable &getVariable(bool global, int slot) {
+    return global ? variables.getGlobal(slot) : variables.getLocal(slot);
+  }
+
+  ExprValue executeLeia(int type = TIPO_LITERAL);
+  void executeImprima(list<ExprValue> &args);
+
+  // abortam a execucao lancando ExecutionError
+  void runtimeError(const string &msg);
+  void limitExceeded(const string &msg);
+
+  static string parseLiteral(string str);
+  static int parseChar(const string &str);
+
   //----------- Debugger -------------------------
 
-  void nextCmd(const string &file, int line);
+  // chamado antes de cada comando. Sem depurador conectado, apenas
+  // registra a linha atual (usada nas mensagens de erro)
+  void nextCmd(const string &file, int line) {
+    currentLine = line;
+    step();
+    if (profiler.active()) {
+      profiler.line(file, line);
+    }
+    if (debugging) {
+      debugCmd(file, line);
+    }
+  }
+
+  // conta um passo de execucao (comando ou iteracao de laco). Os limites
+  // de passos e de tempo so sao verificados quando steps alcanca nextCheck
+  void step() {
+    if (++stats.steps >= nextCheck) {
+      checkLimits();
+    }
+  }
 
 private:
-  string castLeiaChar(Variable &var, ExprValue &v);
+  enum { CHECK_INTERVAL = 4096 }; // passos entre verificacoes do relogio
 
-  ExprValue executeLeia();
+  void debugCmd(const string &file, int line);
 
-  void executeImprima(list<ExprValue> &args);
+  long long buildFrame(list<Symbol> &symbols, vector<Variable> &frame,
+                       bool allocate);
+  void allocMatrix(Variable &v);
+  void reserveMemory(long long bytes);
+  void checkLimits();
+
+  int matrixOffset(Variable &var, LValue &l);
 
   SymbolTable &stable;
   string dbg_host;
   int dbg_port;
   int currentLine;
 
+  bool debugging;   // sessao de depuracao ativa (debugger conectado)
+  bool interactive; // entrada padrao e' um terminal
   bool currentSkip;
   bool globalSkip;
 
   stack<bool> skipStack;
 
   Variables variables;
+  vector<Function> functions;
+  vector<ExprValue> argsBuffer;
+
+  ExecutionLimits limits;
+  long long nextCheck;
+  long long memory;           // bytes em matrizes (globais e frames ativos)
+  vector<long long> frameMem; // memoria reservada por chamada ativa
+  chrono::steady_clock::time_point deadline;
+  chrono::steady_clock::time_point started;
+
+  InputBuffer input;
+  OutputBuffer output;
+  Profiler profiler;
+  ostream *statsOut;
+  bool finished;
+  InterpreterDBG *debugger; // criado em init() se houver host (gpt -d)
+
   typedef pair<string, int> context_t;
   typedef pair<string, pair<string, int>>
       stack_entry_t; // pair<file, pair<context, line> >
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "OutputBuffer.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+OutputBuffer::OutputBuffer() : used(0), written(0), stream(0) {
+  lineFlush = isatty(1);
+}
+
+OutputBuffer::~OutputBuffer() { flush(); }
+
+void OutputBuffer::setStream(ostream &out) {
+  flush();
+  stream = &out;
+  lineFlush = false;
+}
+
+void OutputBuffer::write(const char *str, int len) {
+  if (stream) {
+    stream->write(str, len);
+  } else {
+    fwrite(str, 1, len, stdout);
+  }
+  written += len;
+}
+
+void OutputBuffer::put(const char *str, int len) {
+  if (used + len > BUFFER_SIZE) {
+    flush();
+    if (len > BUFFER_SIZE) {
+      write(str, len);
+      return;
+    }
+  }
+  memcpy(buffer + used, str, len);
+  used += len;
+}
+
+void OutputBuffer::putInt(int i) {
+  char str[16];
+  char *p = str + sizeof(str);
+  unsigned int u = (i < 0) ? -(unsigned int)i : i;
+
+  do {
+    *--p = '0' + (u % 10);
+    u /= 10;
+  } while (u);
+
+  if (i < 0) {
+    *--p = '-';
+  }
+  put(p, str + sizeof(str) - p);
+}
+
+void OutputBuffer::putReal(float r) {
+  char str[64];
+  int len = snprintf(str, sizeof(str), "%.2f", r);
+  if (len >= (int)sizeof(str)) { // valores muito grandes
+    string big(len + 1, '\0');
+    snprintf(&big[0], big.size(), "%.2f", r);
+    put(big.c_str(), len);
+    return;
+  }
+  put(str, len);
+}
+
+void OutputBuffer::putChar(char c) {
+  if (used == BUFFER_SIZE) {
+    flush();
+  }
+  buffer[used++] = c;
+}
+
+void OutputBuffer::putString(const string &str) {
+  put(str.data(), str.length());
+}
+
+void OutputBuffer::endLine() {
+  putChar('\n');
+  if (lineFlush) {
+    flush();
+  }
+}
+
+void OutputBuffer::flush() {
+  if (used) {
+    write(buffer, used);
+    used = 0;
+  }
+  if (stream) {
+    stream->flush();
+  } else {
+    fflush(stdout);
+  }
+}
@@ -0,0 +1,64 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef OUTPUTBUFFER_HPP
+#define OUTPUTBUFFER_HPP
+
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+// saida padrao do interpretador (imprima). Os dados sao acumulados e
+// escritos de uma vez quando o buffer enche, antes de uma leitura do
+// terminal e ao final do programa. Se a saida for um terminal, cada
+// linha e' escrita imediatamente.
+class OutputBuffer {
+public:
+  OutputBuffer();
+  ~OutputBuffer();
+
+  // escreve em "out" em vez da saida padrao
+  void setStream(ostream &out);
+
+  void putInt(int i);
+  void putReal(float r); // formato fixo, 2 casas decimais
+  void putChar(char c);
+  void putString(const string &str);
+  void endLine();
+
+  void flush();
+
+  long long bytesWritten() const { return written + used; }
+
+private:
+  enum { BUFFER_SIZE = 64 * 1024 };
+
+  void put(const char *str, int len);
+  void write(const char *str, int len);
+
+  char buffer[BUFFER_SIZE];
+  int used;
+  long long written; // bytes ja enviados para a saida
+  bool lineFlush;
+  ostream *stream; // ou 0, para a saida padrao
+};
+
+#endif
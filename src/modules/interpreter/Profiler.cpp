@@ -0,0 +1,215 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+Profiler::Profiler() : enabled(false), lastLines(0) {
+  mainStats.name = "(principal)";
+}
+
+Profiler::~Profiler() { write(); }
+
+bool Profiler::open(const string &file) {
+  report.open(file.c_str(), ios_base::out);
+  folded.open((file + ".folded").c_str(), ios_base::out);
+  enabled = report && folded;
+  return enabled;
+}
+
+void Profiler::addFunction(int func, const string &name) {
+  if ((int)functions.size() <= func) {
+    functions.resize(func + 1);
+  }
+  functions[func].name = name;
+}
+
+void Profiler::line(const string &file, int line) {
+  if (!lastLines || (file != lastFile)) {
+    lastFile = file;
+    lastLines = &lines[file];
+  }
+  if ((int)lastLines->size() <= line) {
+    lastLines->resize(line + 1);
+  }
+  (*lastLines)[line]++;
+}
+
+void Profiler::enter(int func) {
+  int node;
+  if (frames.empty()) {
+    if (nodes.empty()) {
+      Node root;
+      root.func = func;
+      root.self = 0;
+      nodes.push_back(root);
+    }
+    node = 0;
+  } else {
+    Node &parent = nodes[frames.back().node];
+    map<int, int>::iterator it = parent.children.find(func);
+    if (it != parent.children.end()) {
+      node = it->second;
+    } else {
+      node = nodes.size();
+      parent.children[func] = node;
+      Node n;
+      n.func = func;
+      n.self = 0;
+      nodes.push_back(n); // invalida "parent"
+    }
+  }
+
+  Stats &st = stats(func);
+  st.calls++;
+  st.active++;
+
+  Frame f;
+  f.node = node;
+  f.children = 0;
+  f.start = Clock::now();
+  frames.push_back(f);
+}
+
+void Profiler::leave() {
+  Frame &f = frames.back();
+  long long elapsed =
+      chrono::duration_cast<chrono::nanoseconds>(Clock::now() - f.start)
+          .count();
+  long long self = elapsed - f.children;
+
+  Node &n = nodes[f.node];
+  n.self += self;
+
+  Stats &st = stats(n.func);
+  st.exclusive += self;
+  if (--st.active == 0) {
+    st.inclusive += elapsed;
+  }
+
+  frames.pop_back();
+  if (!frames.empty()) {
+    frames.back().children += elapsed;
+  }
+}
+
+static bool byExclusive(const pair<long long, string> &a,
+                        const pair<long long, string> &b) {
+  return a.first > b.first;
+}
+
+void Profiler::write() {
+  if (!enabled) {
+    return;
+  }
+  enabled = false;
+
+  while (!frames.empty()) { // algoritmo interrompido por um erro
+    leave();
+  }
+
+  // funcoes, da que mais consumiu tempo exclusivo para a que menos
+  vector<pair<long long, string>> rows;
+  vector<Stats *> all;
+  all.push_back(&mainStats);
+  for (unsigned i = 0; i < functions.size(); i++) {
+    if (functions[i].calls) {
+      all.push_back(&functions[i]);
+    }
+  }
+
+  report << "Perfil de execução\n\n"
+            "Funções (tempos em milissegundos)\n\n"
+         << setw(10) << "chamadas" << setw(14) << "inclusivo" << setw(14)
+         << "exclusivo"
+         << "  função\n";
+  for (unsigned i = 0; i < all.size(); i++) {
+    stringstream s;
+    s << fixed << setprecision(3) << setw(10) << all[i]->calls << setw(14)
+      << all[i]->inclusive / 1e6 << setw(14) << all[i]->exclusive / 1e6
+      << "  " << all[i]->name << "\n";
+    rows.push_back(make_pair(all[i]->exclusive, s.str()));
+  }
+  stable_sort(rows.begin(), rows.end(), byExclusive);
+  for (unsigned i = 0; i < rows.size(); i++) {
+    report << rows[i].second;
+  }
+
+  report << "\nExecuções por linha\n\n"
+         << setw(12) << "execuções" // setw conta bytes (UTF-8)
+         << "  arquivo:linha\n";
+  for (map<string, vector<long long>>::iterator it = lines.begin();
+       it != lines.end(); ++it) {
+    for (unsigned l = 0; l < it->second.size(); l++) {
+      if (it->second[l]) {
+        report << setw(10) << it->second[l] << "  " << it->first << ":" << l
+               << "\n";
+      }
+    }
+  }
+  report.close();
+
+  if (!nodes.empty()) {
+    writeFolded();
+  }
+  folded.close();
+}
+
+// percorre a arvore sem recursao, com um unico buffer de caminho: o nome
+// da funcao e' anexado ao entrar no no e removido ao sair
+void Profiler::writeFolded() {
+  struct Visit {
+    int node;
+    size_t length; // tamanho do caminho antes do no
+    map<int, int>::iterator next;
+  };
+  vector<Visit> pending;
+  string path;
+
+  int node = 0;
+  for (;;) {
+    Node &n = nodes[node];
+    Visit v = {node, path.size(), n.children.begin()};
+    pending.push_back(v);
+    if (!path.empty()) {
+      path += ';';
+    }
+    path += stats(n.func).name;
+
+    long long us = n.self / 1000;
+    if (us > 0) {
+      folded << path << " " << us << "\n";
+    }
+
+    while (!pending.empty() &&
+           (pending.back().next == nodes[pending.back().node].children.end())) {
+      path.resize(pending.back().length);
+      pending.pop_back();
+    }
+    if (pending.empty()) {
+      break;
+    }
+    node = (pending.back().next++)->second;
+  }
+}
@@ -0,0 +1,98 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// perfil de execucao do interpretador (--profile): numero de execucoes de
+// cada linha e tempo inclusivo/exclusivo de cada funcao. Ao final, grava
+// um relatorio no arquivo indicado e as pilhas de chamadas no formato
+// "folded" (uma pilha por linha, com o tempo exclusivo em microssegundos),
+// aceito pelas ferramentas de flamegraph, no mesmo arquivo com ".folded".
+class Profiler {
+public:
+  enum { MAIN = -1 }; // bloco principal do algoritmo
+
+  Profiler();
+  ~Profiler();
+
+  bool open(const string &file);
+  bool active() const { return enabled; }
+
+  void addFunction(int func, const string &name); // func: Symbol::slot
+
+  void line(const string &file, int line);
+  void enter(int func);
+  void leave();
+
+  void write(); // encerra as chamadas pendentes e grava os arquivos
+
+private:
+  typedef chrono::steady_clock Clock;
+
+  struct Stats {
+    Stats() : calls(0), inclusive(0), exclusive(0), active(0) {}
+    string name;
+    long long calls;
+    long long inclusive; // ns, chamadas recursivas contadas uma vez
+    long long exclusive; // ns
+    int active;          // chamadas em andamento
+  };
+
+  struct Node { // caminho de chamadas a partir do bloco principal
+    int func;
+    long long self; // tempo exclusivo neste caminho (ns)
+    map<int, int> children;
+  };
+
+  struct Frame {
+    int node;
+    Clock::time_point start;
+    long long children; // tempo gasto nas funcoes chamadas (ns)
+  };
+
+  Stats &stats(int func) { return (func == MAIN) ? mainStats : functions[func]; }
+
+  void writeFolded();
+
+  bool enabled;
+  ofstream report;
+  ofstream folded;
+
+  Stats mainStats;
+  vector<Stats> functions; // indexado por Symbol::slot
+  vector<Node> nodes;      // nodes[0]: bloco principal
+  vector<Frame> frames;
+
+  map<string, vector<long long>> lines; // execucoes por arquivo e linha
+  string lastFile;
+  vector<long long> *lastLines;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "RuntimeStats.hpp"
+
+#include <iomanip>
+
+void RuntimeStats::write(ostream &out, const string &result) const {
+  out << "{\"resultado\": \"" << result << "\""
+      << ", \"passos\": " << steps << ", \"chamadas\": " << calls
+      << ", \"profundidade_maxima\": " << maxDepth
+      << ", \"matriz_leituras\": " << matrixReads
+      << ", \"matriz_escritas\": " << matrixWrites
+      << ", \"verificacoes_indices\": " << boundsChecks
+      << ", \"leia_chamadas\": " << leiaCalls
+      << ", \"leia_bytes\": " << leiaBytes
+      << ", \"imprima_chamadas\": " << imprimaCalls
+      << ", \"imprima_bytes\": " << imprimaBytes
+      << ", \"memoria_pico_bytes\": " << peakMemory << ", \"tempo\": {";
+
+  ios_base::fmtflags flags = out.flags();
+  out << fixed << setprecision(6);
+  for (unsigned i = 0; i < phases.size(); i++) {
+    out << (i ? ", " : "") << "\"" << phases[i].first
+        << "\": " << phases[i].second;
+  }
+  out.flags(flags);
+
+  out << "}}" << endl;
+}
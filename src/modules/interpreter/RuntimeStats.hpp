@@ -0,0 +1,63 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef RUNTIMESTATS_HPP
+#define RUNTIMESTATS_HPP
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// contadores de execucao do interpretador (--stats). Sao incrementados
+// sempre, pois custam apenas uma soma, e gravados em JSON ao final da
+// execucao, inclusive quando o algoritmo e' abortado.
+class RuntimeStats {
+public:
+  RuntimeStats()
+      : enabled(false), steps(0), calls(0), maxDepth(0), matrixReads(0),
+        matrixWrites(0), boundsChecks(0), leiaCalls(0), leiaBytes(0),
+        imprimaCalls(0), imprimaBytes(0), peakMemory(0) {}
+
+  // result: "ok", "erro" ou "limite"
+  void write(ostream &out, const string &result) const;
+
+  bool enabled;
+
+  long long steps; // comandos executados e iteracoes de lacos
+  long long calls; // chamadas de funcoes do algoritmo
+  int maxDepth;
+  long long matrixReads;
+  long long matrixWrites;
+  long long boundsChecks; // indices verificados
+  long long leiaCalls;
+  long long leiaBytes;
+  long long imprimaCalls;
+  long long imprimaBytes;
+  long long peakMemory; // bytes em matrizes (ver ExecutionLimits)
+
+  // tempo gasto (segundos) em cada fase, na ordem em que ocorreram
+  vector<pair<string, double>> phases;
+};
+
+#endif
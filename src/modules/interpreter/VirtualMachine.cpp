@@ -0,0 +1,530 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "config.h"
+
+#include "VirtualMachine.hpp"
+
+#include <sstream>
+
+// despacho por "computed goto" quando suportado pelo compilador
+#if defined(__GNUC__)
+#define VM_COMPUTED_GOTO
+#endif
+
+VirtualMachine::VirtualMachine(SymbolTable &st, Bytecode &p, string host,
+                               int port)
+    : program(p), interpreter(st, host, port), stack(256), sp(0) {}
+
+void VirtualMachine::push(const Value &v) {
+  if (sp == (int)stack.size()) {
+    stack.resize(stack.size() * 2);
+  }
+  static_cast<Value &>(stack[sp++]) = v;
+}
+
+// desempilha os indices de var[i][j]... e retorna a posicao do elemento
+int VirtualMachine::popOffset(Variable &var) {
+  const vector<int> &dims = var.matrix.dims();
+  int n = dims.size();
+  int off = 0;
+
+  sp -= n;
+  interpreter.stats.boundsChecks += n;
+  for (int i = 0; i < n; i++) {
+    int idx = stack[sp + i].toInt();
+    if ((idx < 0) || (idx >= dims[i])) {
+      stringstream s;
+      s << "Overflow em \"" << var.name;
+      for (int j = 0; j < n; j++) {
+        s << "[" << stack[sp + j].toInt() << "]";
+      }
+      s << "\"";
+      interpreter.runtimeError(s.str());
+    }
+    off = off * dims[i] + idx;
+  }
+  return off;
+}
+
+int &VirtualMachine::counter(Loop &l) {
+  Variable &var = interpreter.getVariable(l.global, l.slot);
+  if (l.offset < 0) {
+    return var.primitiveValue.num.i;
+  }
+  return var.matrix.intRef(l.offset);
+}
+
+int VirtualMachine::run() {
+  const Bytecode::Instruction *code = &program.code[0];
+  const Bytecode::Instruction *pc = code;
+
+  interpreter.init(program.files.front());
+
+#ifdef VM_COMPUTED_GOTO
+  static void *labels[Bytecode::OP_COUNT] = {
+      &&L_OP_LINE,     &&L_OP_PUSH,     &&L_OP_POP,       &&L_OP_LOAD,
+      &&L_OP_LOADM,    &&L_OP_LOADE,    &&L_OP_STORE,     &&L_OP_STOREE,
+      &&L_OP_OU,       &&L_OP_E,        &&L_OP_BIT_OU,    &&L_OP_BIT_XOU,
+      &&L_OP_BIT_E,    &&L_OP_IGUAL,    &&L_OP_DIF,       &&L_OP_MAIOR,
+      &&L_OP_MENOR,    &&L_OP_MAIOR_EQ, &&L_OP_MENOR_EQ,  &&L_OP_MAIS,
+      &&L_OP_MENOS,    &&L_OP_DIV,      &&L_OP_MULTIP,    &&L_OP_MOD,
+      &&L_OP_NEG,      &&L_OP_NOT,      &&L_OP_BNOT,      &&L_OP_JMP,
+      &&L_OP_JZ,       &&L_OP_OU_JMP,   &&L_OP_E_JMP,     &&L_OP_CALL,
+      &&L_OP_RET,      &&L_OP_LEIA,     &&L_OP_IMPRIMA,   &&L_OP_FOR_REF,
+      &&L_OP_FOR_SET,  &&L_OP_FOR_TEST, &&L_OP_FOR_STEP,  &&L_OP_FOR_END,
+      &&L_OP_FOR_BOUND, &&L_OP_FOR_CHECK, &&L_OP_FOR_NEXT, &&L_OP_LOOP,
+      &&L_OP_TOREAL,   &&L_OP_BIT_OU_I, &&L_OP_BIT_XOU_I, &&L_OP_BIT_E_I,
+      &&L_OP_IGUAL_I,  &&L_OP_IGUAL_R,  &&L_OP_IGUAL_L,   &&L_OP_DIF_I,
+      &&L_OP_DIF_R,    &&L_OP_DIF_L,    &&L_OP_MAIOR_I,   &&L_OP_MAIOR_R,
+      &&L_OP_MENOR_I,  &&L_OP_MENOR_R,  &&L_OP_MAIOR_EQ_I, &&L_OP_MAIOR_EQ_R,
+      &&L_OP_MENOR_EQ_I, &&L_OP_MENOR_EQ_R, &&L_OP_MAIS_I, &&L_OP_MAIS_R,
+      &&L_OP_MENOS_I,  &&L_OP_MENOS_R,  &&L_OP_DIV_I,     &&L_OP_DIV_R,
+      &&L_OP_MULTIP_I, &&L_OP_MULTIP_R, &&L_OP_MOD_I,     &&L_OP_NEG_I,
+      &&L_OP_NEG_R,    &&L_OP_HALT};
+
+#define TARGET(op) L_##op:
+#define DISPATCH() goto *labels[pc->op]
+  DISPATCH();
+#else
+#define TARGET(op) case Bytecode::op:
+#define DISPATCH() continue
+  for (;;) {
+    switch (pc->op) {
+#endif
+
+#define BINARY_OP(op, func)                                                    \
+  TARGET(op) {                                                                 \
+    sp--;                                                                      \
+    static_cast<Value &>(stack[sp - 1]) =                                      \
+        interpreter.func(stack[sp - 1], stack[sp]);                            \
+    pc++;                                                                      \
+    DISPATCH();                                                                \
+  }
+
+#define UNARY_OP(op, func)                                                     \
+  TARGET(op) {                                                                 \
+    interpreter.func(stack[sp - 1]);                                           \
+    pc++;                                                                      \
+    DISPATCH();                                                                \
+  }
+
+// operacoes especializadas: operandos ja tem o tipo esperado (emitTyped)
+#define TYPED_OP(op, field, rtype, expr)                                       \
+  TARGET(op) {                                                                 \
+    sp--;                                                                      \
+    Value &l = stack[sp - 1];                                                  \
+    Value &r = stack[sp];                                                      \
+    l.field = (expr);                                                          \
+    l.type = rtype;                                                            \
+    pc++;                                                                      \
+    DISPATCH();                                                                \
+  }
+
+#define INT_OP(op, oper)                                                       \
+  TYPED_OP(op, num.i, TIPO_INTEIRO, l.num.i oper r.num.i)
+#define REAL_OP(op, oper) TYPED_OP(op, num.r, TIPO_REAL, l.num.r oper r.num.r)
+#define INT_CMP(op, oper)                                                      \
+  TYPED_OP(op, num.i, TIPO_LOGICO, (l.num.i oper r.num.i) ? 1 : 0)
+#define REAL_CMP(op, oper)                                                     \
+  TYPED_OP(op, num.i, TIPO_LOGICO, (l.num.r oper r.num.r) ? 1 : 0)
+
+    TARGET(OP_LINE) {
+      interpreter.nextCmd(program.files[pc->b], pc->a);
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_PUSH) {
+      push(program.constants[pc->a]);
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_POP) {
+      sp--;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_LOAD) {
+      push(interpreter.getVariable(pc->a, pc->b).primitiveValue);
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_LOADM) {
+      Variable &var = interpreter.getVariable(pc->a, pc->b);
+      push(Value(var.type));
+      stack[sp - 1].matrix = var.matrix;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_LOADE) {
+      Variable &var = interpreter.getVariable(pc->a, pc->b);
+      int off = popOffset(var);
+      push(var.matrix.get(off));
+      interpreter.stats.matrixReads++;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_STORE) {
+      interpreter.getVariable(pc->a, pc->b).setValue(stack[--sp]);
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_STOREE) {
+      Variable &var = interpreter.getVariable(pc->a, pc->b);
+      ExprValue &v = stack[--sp];
+      int off = popOffset(var);
+      var.setValue(off, v);
+      interpreter.stats.matrixWrites++;
+      pc++;
+      DISPATCH();
+    }
+
+    BINARY_OP(OP_OU, evaluateOu)
+    BINARY_OP(OP_E, evaluateE)
+    BINARY_OP(OP_BIT_OU, evaluateBitOu)
+    BINARY_OP(OP_BIT_XOU, evaluateBitXou)
+    BINARY_OP(OP_BIT_E, evaluateBitE)
+    BINARY_OP(OP_IGUAL, evaluateIgual)
+    BINARY_OP(OP_DIF, evaluateDif)
+    BINARY_OP(OP_MAIOR, evaluateMaior)
+    BINARY_OP(OP_MENOR, evaluateMenor)
+    BINARY_OP(OP_MAIOR_EQ, evaluateMaiorEq)
+    BINARY_OP(OP_MENOR_EQ, evaluateMenorEq)
+    BINARY_OP(OP_MAIS, evaluateMais)
+    BINARY_OP(OP_MENOS, evaluateMenos)
+    BINARY_OP(OP_DIV, evaluateDiv)
+    BINARY_OP(OP_MULTIP, evaluateMultip)
+    BINARY_OP(OP_MOD, evaluateMod)
+
+    UNARY_OP(OP_NEG, evaluateUnNeg)
+    UNARY_OP(OP_NOT, evaluateUnNot)
+    UNARY_OP(OP_BNOT, evaluateUnBNot)
+
+    TARGET(OP_TOREAL) {
+      Value &v = stack[sp - 1 - pc->a];
+      v.num.r = (float)v.num.i;
+      v.type = TIPO_REAL;
+      pc++;
+      DISPATCH();
+    }
+
+    INT_OP(OP_BIT_OU_I, |)
+    INT_OP(OP_BIT_XOU_I, ^)
+    INT_OP(OP_BIT_E_I, &)
+    INT_OP(OP_MAIS_I, +)
+    INT_OP(OP_MENOS_I, -)
+    INT_OP(OP_MULTIP_I, *)
+    REAL_OP(OP_MAIS_R, +)
+    REAL_OP(OP_MENOS_R, -)
+    REAL_OP(OP_MULTIP_R, *)
+
+    INT_CMP(OP_IGUAL_I, ==)
+    INT_CMP(OP_DIF_I, !=)
+    INT_CMP(OP_MAIOR_I, >)
+    INT_CMP(OP_MENOR_I, <)
+    INT_CMP(OP_MAIOR_EQ_I, >=)
+    INT_CMP(OP_MENOR_EQ_I, <=)
+    REAL_CMP(OP_IGUAL_R, ==)
+    REAL_CMP(OP_DIF_R, !=)
+    REAL_CMP(OP_MAIOR_R, >)
+    REAL_CMP(OP_MENOR_R, <)
+    REAL_CMP(OP_MAIOR_EQ_R, >=)
+    REAL_CMP(OP_MENOR_EQ_R, <=)
+
+    TARGET(OP_DIV_I) {
+      if (stack[sp - 1].num.i == 0) {
+        interpreter.runtimeError("Divisão por 0 é ilegal");
+      }
+      sp--;
+      // INT_MIN / -1 gera SIGFPE; o resultado com complemento de 2 e' INT_MIN
+      if (stack[sp].num.i == -1) {
+        stack[sp - 1].num.i = (int)(0u - (unsigned)stack[sp - 1].num.i);
+      } else {
+        stack[sp - 1].num.i /= stack[sp].num.i;
+      }
+      stack[sp - 1].type = TIPO_INTEIRO;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_MOD_I) {
+      if (stack[sp - 1].num.i == 0) {
+        interpreter.runtimeError("Divisão por 0 é ilegal");
+      }
+      sp--;
+      // idem para INT_MIN % -1; o resto por -1 e' sempre 0
+      if (stack[sp].num.i == -1) {
+        stack[sp - 1].num.i = 0;
+      } else {
+        stack[sp - 1].num.i %= stack[sp].num.i;
+      }
+      stack[sp - 1].type = TIPO_INTEIRO;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_DIV_R) {
+      if (stack[sp - 1].num.r == 0) {
+        interpreter.runtimeError("Divisão por 0 é ilegal");
+      }
+      sp--;
+      stack[sp - 1].num.r /= stack[sp].num.r;
+      stack[sp - 1].type = TIPO_REAL;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_IGUAL_L) {
+      sp--;
+      stack[sp - 1].setBool(stack[sp - 1].lit.str() == stack[sp].lit.str());
+      stack[sp - 1].lit = Literal();
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_DIF_L) {
+      sp--;
+      stack[sp - 1].setBool(stack[sp - 1].lit.str() != stack[sp].lit.str());
+      stack[sp - 1].lit = Literal();
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_NEG_I) {
+      stack[sp - 1].num.i = -stack[sp - 1].num.i;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_NEG_R) {
+      stack[sp - 1].num.r = -stack[sp - 1].num.r;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_JMP) {
+      pc = code + pc->a;
+      DISPATCH();
+    }
+
+    TARGET(OP_JZ) {
+      if (stack[--sp].ifTrue()) {
+        pc++;
+      } else {
+        pc = code + pc->a;
+      }
+      DISPATCH();
+    }
+
+    TARGET(OP_OU_JMP) {
+      if (stack[sp - 1].ifTrue()) {
+        stack[sp - 1].setBool(true);
+        pc = code + pc->a;
+      } else {
+        pc++;
+      }
+      DISPATCH();
+    }
+
+    TARGET(OP_E_JMP) {
+      if (stack[sp - 1].ifTrue()) {
+        pc++;
+      } else {
+        stack[sp - 1].setBool(false);
+        pc = code + pc->a;
+      }
+      DISPATCH();
+    }
+
+    TARGET(OP_CALL) {
+      Bytecode::Function &f = program.functions[pc->a];
+
+      sp -= f.params;
+      interpreter.beginFunctionCall(f.file, pc->a, &stack[sp], pc->b);
+      for (int i = 0; i < f.params; i++) {
+        if (stack[sp + i].matrix.size) {
+          stack[sp + i].matrix = Matrix();
+        }
+      }
+
+      Frame fr;
+      fr.ret = (pc - code) + 1;
+      fr.function = pc->a;
+      fr.loops = loops.size();
+      frames.push_back(fr);
+
+      pc = code + f.entry;
+      DISPATCH();
+    }
+
+    TARGET(OP_RET) {
+      if (pc->a == Bytecode::RET_VALUE) {
+        interpreter.setReturnExprValue(stack[--sp]);
+      } else if (pc->a == Bytecode::RET_NULL) {
+        interpreter.setReturnExprValue(nullValue);
+      }
+
+      Frame &fr = frames.back();
+      loops.resize(fr.loops);
+      interpreter.endFunctionCall();
+      push(interpreter.getReturnExprValue(fr.function));
+
+      pc = code + fr.ret;
+      frames.pop_back();
+      DISPATCH();
+    }
+
+    TARGET(OP_LEIA) {
+      push(interpreter.executeLeia(pc->a));
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_IMPRIMA) {
+      sp -= pc->a;
+      printArgs.assign(&stack[sp], &stack[sp] + pc->a);
+      interpreter.executeImprima(printArgs);
+      push(nullValue);
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_FOR_REF) {
+      loops.push_back(Loop());
+      Loop &l = loops.back();
+      l.global = pc->a;
+      l.slot = pc->b;
+
+      Variable &var = interpreter.getVariable(l.global, l.slot);
+      l.offset = var.isPrimitive ? -1 : popOffset(var);
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_FOR_SET) {
+      Loop &l = loops.back();
+      Variable &var = interpreter.getVariable(l.global, l.slot);
+      if (l.offset < 0) {
+        var.setValue(stack[--sp]);
+      } else {
+        var.setValue(l.offset, stack[--sp]);
+      }
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_FOR_TEST) {
+      Loop &l = loops.back();
+      l.ate = stack[--sp];
+      l.bound = l.ate.toInt();
+
+      bool exec;
+      if (pc->b > 0) {
+        exec = counter(l) <= l.bound;
+      } else {
+        exec = counter(l) >= l.bound;
+      }
+
+      if (exec) {
+        pc++;
+      } else {
+        pc = code + pc->a;
+      }
+      DISPATCH();
+    }
+
+    TARGET(OP_FOR_STEP) {
+      counter(loops.back()) += pc->a;
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_FOR_END) {
+      // lv deve ter um valor a mais do que ate (ou a menos, se loop
+      // decrescente). setar o valor de lv para valor de ate
+      Loop &l = loops.back();
+      Variable &var = interpreter.getVariable(l.global, l.slot);
+      if (l.offset < 0) {
+        var.setValue(l.ate);
+      } else {
+        var.setValue(l.offset, l.ate);
+      }
+      loops.pop_back();
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_FOR_BOUND) {
+      Loop &l = loops.back();
+      l.ate = stack[--sp];
+      l.bound = l.ate.toInt();
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_FOR_CHECK) {
+      Loop &l = loops.back();
+      int i = counter(l);
+      if ((pc->b > 0) ? (i <= l.bound) : (i >= l.bound)) {
+        pc++;
+      } else {
+        pc = code + pc->a;
+      }
+      DISPATCH();
+    }
+
+    TARGET(OP_FOR_NEXT) {
+      // passo e teste em uma so instrucao
+      Loop &l = loops.back();
+      int &i = counter(l);
+      i += pc->b;
+      if ((pc->b > 0) ? (i <= l.bound) : (i >= l.bound)) {
+        pc = code + pc->a;
+      } else {
+        pc++;
+      }
+      DISPATCH();
+    }
+
+    TARGET(OP_LOOP) {
+      interpreter.step();
+      pc++;
+      DISPATCH();
+    }
+
+    TARGET(OP_HALT) {
+      if (pc->a) {
+        return stack[--sp].toInt();
+      }
+      return 0;
+    }
+
+#ifndef VM_COMPUTED_GOTO
+    }
+  }
+#endif
+}
@@ -0,0 +1,91 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#ifndef VIRTUALMACHINE_HPP
+#define VIRTUALMACHINE_HPP
+
+#include "Bytecode.hpp"
+#include "InterpreterEval.hpp"
+#include "SymbolTable.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// executa o programa gerado por BytecodeWalker. Chamadas de funcoes nao
+// usam recursao nativa: os registros de ativacao ficam em "frames".
+class VirtualMachine {
+public:
+  VirtualMachine(SymbolTable &st, Bytecode &program, string host, int port);
+
+  void setLimits(const ExecutionLimits &l) { interpreter.setLimits(l); }
+  bool setProfile(const string &file) { return interpreter.setProfile(file); }
+  void enableStats(const vector<pair<string, double>> &phases,
+                   ostream &out = cerr) {
+    interpreter.enableStats(phases, out);
+  }
+  void setStreams(istream &in, ostream &out) {
+    interpreter.setStreams(in, out);
+  }
+
+  // grava perfil e estatisticas e retorna os contadores da execucao
+  const RuntimeStats &finish() {
+    interpreter.finish("ok");
+    return interpreter.stats;
+  }
+
+  int run();
+
+private:
+  struct Frame {
+    int ret;      // endereco de retorno
+    int function; // indice em Bytecode::functions
+    int loops;    // loops.size() no momento da chamada
+  };
+
+  struct Loop { // variavel de controle de um "para"
+    bool global;
+    int slot;
+    int offset; // -1 se primitiva
+    Value ate;
+    int bound; // ate.toInt()
+  };
+
+  void push(const Value &v);
+  int popOffset(Variable &var);
+  int &counter(Loop &l);
+
+  Bytecode &program;
+  InterpreterEval interpreter;
+
+  vector<ExprValue> stack;
+  int sp;
+
+  vector<Frame> frames;
+  vector<Loop> loops;
+
+  // os blocos de run() nao devem declarar objetos com destrutor: o despacho
+  // por computed goto sai do bloco sem destrui-los
+  list<ExprValue> printArgs;
+  ExprValue nullValue;
+};
+
+#endif
@@ -0,0 +1,361 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+header {
+   #include "PortugolAST.hpp"
+   #include "SymbolTable.hpp"
+   #include "Bytecode.hpp"
+   #include <string>
+
+   using namespace std;
+}
+//-------------------------------------------------------------------------------
+
+options {
+  language="Cpp";
+}
+
+// Compila a arvore sintatica para o bytecode executado por VirtualMachine.
+
+class BytecodeWalker extends TreeParser;
+options {
+  importVocab=Portugol;  // use vocab generated by lexer
+  ASTLabelType="RefPortugolAST";
+  noConstructors=true;
+  genHashLines=false;//no #line
+}
+
+{
+  public:
+    BytecodeWalker(SymbolTable& st, Bytecode& bc)
+      : stable(st), program(bc), scope(SymbolTable::GlobalScope), leiaType(TIPO_LITERAL) {    }
+
+  private:
+    SymbolTable& stable;
+    Bytecode& program;
+    string scope;
+
+    //tipo de destino de "x := leia()", lido diretamente por OP_LEIA
+    int leiaType;
+
+    bool isLeia(RefPortugolAST node) {
+      return (node->getType() == TI_FCALL) && (node->getFirstChild()->getText() == "leia");
+    }
+
+    int fileIndex(RefPortugolAST node) {
+      return program.addFile(node->getFilename());
+    }
+
+    //operacao binaria especializada pelos tipos dos operandos (eval_type)
+    void emitBinary(RefPortugolAST op, int generic) {
+      RefPortugolAST left = op->getFirstChild();
+      RefPortugolAST right = left->getNextSibling();
+      program.emitTyped(generic, left->getEvalType(), right->getEvalType());
+    }
+}
+
+
+/****************************** TREE WALKER *********************************************/
+
+algoritmo
+{
+  program.addFile(_t->getFilename());
+  _t = _t->getNextSibling();
+  if(_t->getType() == T_KW_VARIAVEIS) {
+    _t = _t->getNextSibling(); //pula declaracao de algoritmo e variaveis
+  }
+}
+  : inicio[true] (func_decls)*
+  ;
+
+inicio[bool principal]
+  : #(t:T_KW_INICIO (stm)*)
+    {
+      program.emit(Bytecode::OP_LINE, t->getEndLine(), fileIndex(t));
+      if(principal) {
+        program.emit(Bytecode::OP_HALT, 0);
+      } else {
+        program.emit(Bytecode::OP_RET, Bytecode::RET_END);
+      }
+    }
+  ;
+
+stm
+{
+  program.emit(Bytecode::OP_LINE, _t->getLine(),
+    fileIndex(static_cast<RefPortugolAST>(_t->getFirstChild())));
+}
+  : stm_attr
+  | fcall {program.emit(Bytecode::OP_POP);}
+  | stm_ret
+  | stm_se
+  | stm_enquanto
+  | stm_repita
+  | stm_para
+  ;
+
+stm_attr
+{
+  RefPortugolAST id;
+}
+  : #(t:T_ATTR
+      id=lvalue
+      {
+        if(isLeia(_t)) {
+          leiaType = stable.getSymbol(scope, id->getText(), true).type.primitiveType();
+        }
+      }
+      expr
+    )
+    {
+      if(id->getFirstChild() != antlr::nullAST) {
+        program.emit(Bytecode::OP_STOREE, id->isGlobalSlot(), id->getSlot());
+      } else {
+        program.emit(Bytecode::OP_STORE, id->isGlobalSlot(), id->getSlot());
+      }
+    }
+  ;
+
+// emite os indices (se houver) e retorna o identificador
+lvalue returns [RefPortugolAST node]
+  : #(id:T_IDENTIFICADOR (expr)*)
+    {node = id;}
+  ;
+
+fcall
+{
+  int nargs = 0;
+}
+  : #(TI_FCALL id:T_IDENTIFICADOR
+      (
+        expr {nargs++;}
+      )*
+    )
+    {
+      if(id->getText() == "leia") {
+        program.emit(Bytecode::OP_LEIA, leiaType);
+        leiaType = TIPO_LITERAL;
+      } else if(id->getText() == "imprima") {
+        program.emit(Bytecode::OP_IMPRIMA, nargs);
+      } else {
+        program.emit(Bytecode::OP_CALL, id->getSlot(), id->getLine());
+      }
+    }
+  ;
+
+stm_ret
+options {
+  defaultErrorHandler=false; //noviable should be caught on expr
+}
+{
+  bool hasValue = true;
+}
+  : #(r:T_KW_RETORNE (TI_NULL {hasValue = false;}|expr))
+    {
+      if(scope == SymbolTable::GlobalScope) {
+        program.emit(Bytecode::OP_HALT, hasValue);
+      } else {
+        program.emit(Bytecode::OP_RET, hasValue ? Bytecode::RET_VALUE : Bytecode::RET_NULL);
+      }
+    }
+  ;
+
+stm_se
+{
+  int jump;
+}
+  : #(se:T_KW_SE
+      expr {jump = program.emit(Bytecode::OP_JZ);}
+
+      (stm)*
+
+      (T_KW_SENAO
+        {
+          int end = program.emit(Bytecode::OP_JMP);
+          program.patch(jump, program.here());
+          jump = end;
+        }
+        (stm)*
+      )?
+    )
+    {program.patch(jump, program.here());}
+  ;
+
+stm_enquanto
+{
+  int start = program.here();
+  int jump;
+}
+  : #(enq:T_KW_ENQUANTO
+      expr {jump = program.emit(Bytecode::OP_JZ); program.emit(Bytecode::OP_LOOP);}
+      (stm)*
+    )
+    {
+      program.emit(Bytecode::OP_JMP, start);
+      program.patch(jump, program.here());
+    }
+  ;
+
+stm_repita
+{
+  int start = program.here();
+  RefPortugolAST stmNode;
+}
+  : #(rep:T_KW_REPITA
+      {
+        program.emit(Bytecode::OP_LOOP);
+
+        //o ultimo filho eh a expressao de parada
+        stmNode = _t;
+        while(stmNode->getNextSibling() != antlr::nullAST) {
+          stm(stmNode);
+          stmNode = stmNode->getNextSibling();
+        }
+        expr(stmNode);
+        program.emit(Bytecode::OP_JZ, start);
+      }
+    )
+  ;
+
+stm_para
+{
+  RefPortugolAST id;
+  int start, test;
+  int ps = 1;
+  bool invariant = false;
+}
+  : #(para:T_KW_PARA
+        id=lvalue {program.emit(Bytecode::OP_FOR_REF, id->isGlobalSlot(), id->getSlot());}
+        expr      {program.emit(Bytecode::OP_FOR_SET);}
+                  {start = program.here();}
+        expr
+        (ps=passo)?
+        {
+          invariant = para->hasInvariantBound();
+          if(invariant) {
+            //limite avaliado uma unica vez (ver semantic.g)
+            program.emit(Bytecode::OP_FOR_BOUND);
+            test = program.emit(Bytecode::OP_FOR_CHECK, 0, ps);
+            start = program.here();
+          } else {
+            test = program.emit(Bytecode::OP_FOR_TEST, 0, ps);
+          }
+          program.emit(Bytecode::OP_LOOP);
+        }
+        (stm)*
+    )
+    {
+      if(invariant) {
+        program.emit(Bytecode::OP_FOR_NEXT, start, ps);
+      } else {
+        program.emit(Bytecode::OP_FOR_STEP, ps);
+        program.emit(Bytecode::OP_JMP, start);
+      }
+      program.patch(test, program.here());
+      program.emit(Bytecode::OP_FOR_END);
+    }
+  ;
+
+passo returns [int p]
+{bool pos = true;}
+  : #(T_KW_PASSO (T_MAIS|T_MENOS{pos=false;})? i:T_INT_LIT)
+      {p = atoi(i->getText().c_str());if(!pos) p = -p;}
+  ;
+
+expr
+{
+  int jump; //curto-circuito: OP_OU_JMP/OP_E_JMP saltam o operando direito
+}
+  : #(T_KW_OU       expr {jump = program.emit(Bytecode::OP_OU_JMP);}
+                    expr {program.emit(Bytecode::OP_OU); program.patch(jump, program.here());})
+  | #(T_KW_E        expr {jump = program.emit(Bytecode::OP_E_JMP);}
+                    expr {program.emit(Bytecode::OP_E); program.patch(jump, program.here());})
+  | #(bou:T_BIT_OU  expr expr) {emitBinary(bou, Bytecode::OP_BIT_OU);}
+  | #(bxou:T_BIT_XOU expr expr) {emitBinary(bxou, Bytecode::OP_BIT_XOU);}
+  | #(be:T_BIT_E    expr expr) {emitBinary(be, Bytecode::OP_BIT_E);}
+  | #(ig:T_IGUAL    expr expr) {emitBinary(ig, Bytecode::OP_IGUAL);}
+  | #(df:T_DIFERENTE expr expr) {emitBinary(df, Bytecode::OP_DIF);}
+  | #(ma:T_MAIOR    expr expr) {emitBinary(ma, Bytecode::OP_MAIOR);}
+  | #(me:T_MENOR    expr expr) {emitBinary(me, Bytecode::OP_MENOR);}
+  | #(mai:T_MAIOR_EQ expr expr) {emitBinary(mai, Bytecode::OP_MAIOR_EQ);}
+  | #(mei:T_MENOR_EQ expr expr) {emitBinary(mei, Bytecode::OP_MENOR_EQ);}
+  | #(mais:T_MAIS   expr expr) {emitBinary(mais, Bytecode::OP_MAIS);}
+  | #(menos:T_MENOS expr expr) {emitBinary(menos, Bytecode::OP_MENOS);}
+  | #(dv:T_DIV      expr expr) {emitBinary(dv, Bytecode::OP_DIV);}
+  | #(mul:T_MULTIP  expr expr) {emitBinary(mul, Bytecode::OP_MULTIP);}
+  | #(md:T_MOD      expr expr) {emitBinary(md, Bytecode::OP_MOD);}
+  | #(un:TI_UN_NEG  element)
+      {program.emitTyped(Bytecode::OP_NEG, un->getEvalType(), un->getEvalType());}
+  | #(TI_UN_POS     element)
+  | #(TI_UN_NOT     element) {program.emit(Bytecode::OP_NOT);}
+  | #(TI_UN_BNOT    element) {program.emit(Bytecode::OP_BNOT);}
+  | element
+  ;
+
+element
+{
+  RefPortugolAST id;
+}
+  : literal
+  | fcall
+  | id=lvalue
+    {
+      if(id->getFirstChild() != antlr::nullAST) {
+        program.emit(Bytecode::OP_LOADE, id->isGlobalSlot(), id->getSlot());
+      } else if(stable.getSymbol(scope, id->getText(), true).type.isPrimitive()) {
+        program.emit(Bytecode::OP_LOAD, id->isGlobalSlot(), id->getSlot());
+      } else {
+        program.emit(Bytecode::OP_LOADM, id->isGlobalSlot(), id->getSlot());
+      }
+    }
+  | #(TI_PARENTHESIS expr)
+  ;
+
+literal
+{
+  ExprValue v;
+}
+  : (
+      l:T_STRING_LIT     {v.setLiteral(InterpreterEval::parseLiteral(l->getText()));}
+    | i:T_INT_LIT        {v.setInteger(atoi(i->getText().c_str()));}
+    | r:T_REAL_LIT       {v.setReal((float)atof(r->getText().c_str()));}
+    | c:T_CARAC_LIT      {v.setChar(InterpreterEval::parseChar(c->getText()));}
+    | lv:T_KW_VERDADEIRO {v.setBool(true);}
+    | lf:T_KW_FALSO      {v.setBool(false);}
+    )
+    {program.emit(Bytecode::OP_PUSH, program.addConstant(v));}
+  ;
+
+func_decls
+  : #(id:T_IDENTIFICADOR
+      {
+        Symbol& f = stable.getSymbol(SymbolTable::GlobalScope, id->getText());
+
+        scope = id->getText();
+        program.beginFunction(f.slot, id->getFilename(), f.param.symbolList().size());
+
+        while(_t->getType() != T_KW_INICIO) {
+          _t = _t->getNextSibling();
+        }
+      }
+      inicio[false]
+    )
+  ;
@@ -50,83 +50,47 @@ options {
     class ReturnException {};
 
     InterpreterWalker(SymbolTable& st, string host, int port)
-      : interpreter(st, host, port), _returning(false) {    }
+      : stable(st), interpreter(st, host, port), _returning(false) {    }
+
+    void setLimits(const ExecutionLimits& limits) {
+      interpreter.setLimits(limits);
+    }
+
+    bool setProfile(const string& file) {
+      return interpreter.setProfile(file);
+    }
+
+    void enableStats(const vector<pair<string, double> >& phases,
+                     ostream& out = cerr) {
+      interpreter.enableStats(phases, out);
+    }
 
   private:
+    SymbolTable& stable;
     bool _returning;
     InterpreterEval interpreter;
 
-    RefPortugolAST topnode;
-
-    string parseLiteral(string str) {
-      string::size_type idx = 0;
-      char c;
-      while((idx = str.find('\\', idx)) != string::npos) {
-        switch(str[idx+1]) {
-          case 'n':
-            c = '\n';
-            break;
-          case 't':
-            c = '\t';
-            break;
-          case 'r':
-            c = '\r';
-            break;
-          case '\\':
-            c = '\\';
-            break;
-          case '\'':
-            c = '\'';
-            break;
-          case '"':
-            c = '"';
-            break;
-          default:
-            c = str[idx+1];
-        }
-        str.replace(idx, 2, 1, c);
-        idx++;
-      }
-      return str;
-    }
+    //bloco "inicio" de cada funcao, indexado por Symbol::slot
+    vector<RefPortugolAST> functionBodies;
 
-    string parseChar(string str) {
-      stringstream ret;
-      /*
-        ''    => 0
-        'a'   => a
-        '\t'  => \t
-        '\n'  => \n
-        '\r'  => \r
-        '\i'  => i
-      */
-      if(str[0] == '\\') {
-        switch(str[1]) {
-          case 't':
-            ret << (int) '\t';
-            break;
-          case 'n':
-            ret << (int)'\n';
-            break;
-          case 'r':
-            ret << (int) '\r';
-            break;
-          default:
-            ret << (int)str[1];
-        }
-        return ret.str();
-      } else {
-				ret << (int) str[0];
-        return ret.str();
-      }
-    }
+    //literais decodificados, indexados pelo numero dado em ASTOptimizer
+    vector<ExprValue> literals;
 
-    RefPortugolAST getFunctionNode(const string& name) {
-      RefPortugolAST node = topnode;
-      while(node->getText() != name) {
-        node = node->getNextSibling();
+    void locateFunctions(RefPortugolAST node) {
+      for(; node != antlr::nullAST; node = node->getNextSibling()) {
+        if(node->getType() != T_IDENTIFICADOR) {
+          continue;
+        }
+        int f = stable.getSymbol(SymbolTable::GlobalScope, node->getText()).slot;
+        if((int)functionBodies.size() <= f) {
+          functionBodies.resize(f + 1);
+        }
+        RefPortugolAST body = node->getFirstChild();
+        while(body->getType() != T_KW_INICIO) {
+          body = body->getNextSibling();
+        }
+        functionBodies[f] = body;
       }
-      return node;
     }
 }
 
@@ -146,7 +110,7 @@ options {
 algoritmo returns [int ret]
 {
   ret = 0;
-  topnode = _t;
+  locateFunctions(_t);
   interpreter.init(_t->getFilename());
   _t = _t->getNextSibling();
   if(_t->getType() == T_KW_VARIAVEIS) {
@@ -206,7 +170,12 @@ lvalue returns [LValue l]
 {
   ExprValue e;
 }
-  : #(id:T_IDENTIFICADOR {l.name = id->getText();}
+  : #(id:T_IDENTIFICADOR
+      {
+        l.name = id->getText();
+        l.global = id->isGlobalSlot();
+        l.slot = id->getSlot();
+      }
       (
         e=expr {l.addMatrixIndex(e);}
       )*
@@ -225,16 +194,18 @@ fcall returns [ExprValue v]
       )*
     )
     {
-      if(interpreter.isBuiltInFunction(id->getText())) {
-        v = interpreter.execBuiltInFunction(id->getText(), args);
+      int f = id->getSlot(); //resolvido na analise semantica
+      if(interpreter.isBuiltInFunction(f)) {
+        v = interpreter.execBuiltInFunction(f, args);
       } else {
-        RefPortugolAST current = _t; //saves current state
+        RefPortugolAST body = functionBodies[f];
 
-        RefPortugolAST fnode   = getFunctionNode(id->getText()); //gets the function node
+        interpreter.beginFunctionCall(body->getFilename(), f, args, id->getLine());
+        inicio(body);
+        interpreter.endFunctionCall();
 
-        func_decls(fnode, args, id->getLine());                  //executes
         _returning = false;
-        v = interpreter.getReturnExprValue(id->getText());
+        v = interpreter.getReturnExprValue(f);
       }
     }
   ;
@@ -297,6 +268,7 @@ stm_enquanto
         stmNode = first_stm = _t;
 
         while(exec) {
+          interpreter.step(); //iteracao conta como passo (ExecutionLimits)
           while(stmNode != antlr::nullAST) {
             stm(stmNode);
             stmNode = stmNode->getNextSibling();
@@ -318,6 +290,7 @@ stm_repita
       {
         stmNode = first_stm = _t;
         do{
+          interpreter.step();
           while(stmNode->getNextSibling() != antlr::nullAST) {
             stm(stmNode);
 		        stmNode = stmNode->getNextSibling();
@@ -355,18 +328,24 @@ stm_para
 
           stmNode = first_stm = _t;
 
+          //limite invariante: avaliado uma unica vez (ver semantic.g)
+          bool invariant = para->hasInvariantBound();
+          int bound = ate.toInt();
+
           while(true) {
-            if(ps > 0) {
-              if(!interpreter.execLowerEq(lv, ate)) break;
-            } else {
-              if(!interpreter.execBiggerEq(lv, ate)) break;
-            }
+            int i = interpreter.counter(lv);
+            if((ps > 0) ? (i > bound) : (i < bound)) break;
+
+            interpreter.step();
             while(stmNode != antlr::nullAST) {
               stm(stmNode);
               stmNode = stmNode->getNextSibling();
             }
-            interpreter.execPasso(lv, ps);
-            ate = expr(ateNode);
+            interpreter.counter(lv) += ps;
+            if(!invariant) {
+              ate = expr(ateNode);
+              bound = ate.toInt();
+            }
             stmNode = first_stm;
           }
 
@@ -384,9 +363,29 @@ passo returns [int p]
   ;
 
 expr returns [ExprValue v]
-{ExprValue left, right;}
-  : #(T_KW_OU       left=expr right=expr) {v = interpreter.evaluateOu(left, right);}
-  | #(T_KW_E        left=expr right=expr) {v = interpreter.evaluateE(left, right);}
+{
+  ExprValue left, right; //e/ou: o operando direito so e' avaliado se necessario
+}
+  : #(T_KW_OU       left=expr
+        {
+          if(left.ifTrue()) {
+            v.setBool(true);
+          } else {
+            right = expr(_t);
+            v = interpreter.evaluateOu(left, right);
+          }
+        }
+     )
+  | #(T_KW_E        left=expr
+        {
+          if(!left.ifTrue()) {
+            v.setBool(false);
+          } else {
+            right = expr(_t);
+            v = interpreter.evaluateE(left, right);
+          }
+        }
+     )
   | #(T_BIT_OU      left=expr right=expr) {v = interpreter.evaluateBitOu(left, right);}
   | #(T_BIT_XOU     left=expr right=expr) {v = interpreter.evaluateBitXou(left, right);}
   | #(T_BIT_E       left=expr right=expr) {v = interpreter.evaluateBitE(left, right);}
@@ -418,27 +417,29 @@ element returns [ExprValue v]
   ;
 
 literal returns [ExprValue v]
-  : l:T_STRING_LIT     {v.setValue(parseLiteral(l->getText()));v.type = TIPO_LITERAL;}
-  | i:T_INT_LIT        {v.setValue(i->getText());v.type = TIPO_INTEIRO;}
-  | r:T_REAL_LIT       {v.setValue(r->getText());v.type = TIPO_REAL;}
-  | c:T_CARAC_LIT      {v.setValue(parseChar(c->getText()));v.type = TIPO_CARACTERE;}
-  | lv:T_KW_VERDADEIRO {v.setValue("1");v.type = TIPO_LOGICO;}
-  | lf:T_KW_FALSO      {v.setValue("0");v.type = TIPO_LOGICO;}
-  ;
-
-func_decls[list<ExprValue>& args, int line]
-  : #(id:T_IDENTIFICADOR
-      {
-        interpreter.beginFunctionCall(id->getFilename(), id->getText(), args, line);
-
-        while(_t->getType() != T_KW_INICIO) {
-          _t = _t->getNextSibling();
+{
+  //constante ja decodificada: so avanca o no
+  int id = _t->getSlot();
+  if((id >= 0) && (id < (int)literals.size()) &&
+     (literals[id].type != TIPO_NULO)) {
+    _retTree = _t->getNextSibling();
+    return literals[id];
+  }
+}
+  : (
+      l:T_STRING_LIT     {v.setLiteral(InterpreterEval::parseLiteral(l->getText()));}
+    | i:T_INT_LIT        {v.setInteger(atoi(i->getText().c_str()));}
+    | r:T_REAL_LIT       {v.setReal((float)atof(r->getText().c_str()));}
+    | c:T_CARAC_LIT      {v.setChar(InterpreterEval::parseChar(c->getText()));}
+    | lv:T_KW_VERDADEIRO {v.setBool(true);}
+    | lf:T_KW_FALSO      {v.setBool(false);}
+    )
+    {
+      if(id >= 0) {
+        if(id >= (int)literals.size()) {
+          literals.resize(id + 1);
         }
+        literals[id] = v;
       }
-      inicio
-
-      {
-        interpreter.endFunctionCall();
-      }
-    )
+    }
   ;
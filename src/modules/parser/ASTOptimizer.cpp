@@ -0,0 +1,486 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "ASTOptimizer.hpp"
+#include "SemanticWalkerTokenTypes.hpp"
+#include "Symbol.hpp"
+
+#include <climits>
+#include <cmath>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef SemanticWalkerTokenTypes TT;
+
+static bool isIntClass(int type) {
+  return (type == TIPO_INTEIRO) || (type == TIPO_CARACTERE) ||
+         (type == TIPO_LOGICO);
+}
+
+static bool isNumber(int type) {
+  return (type == TIPO_INTEIRO) || (type == TIPO_REAL);
+}
+
+static bool isNumber(const ASTOptimizer::Constant &c, int n) {
+  return ((c.type == TIPO_INTEIRO) && (c.i == n)) ||
+         ((c.type == TIPO_REAL) && (c.r == n));
+}
+
+void ASTOptimizer::optimize(RefPortugolAST node) {
+  literals = 0;
+  for (; node != antlr::nullAST; node = node->getNextSibling()) {
+    fold(node, false);
+    numberLiterals(node);
+  }
+}
+
+// avalia as subexpressoes de baixo para cima. element indica se o no
+// ocupa a posicao de um "element" (operando de um operador unario), onde
+// apenas literais, variaveis, chamadas e parenteses sao permitidos.
+void ASTOptimizer::fold(RefPortugolAST node, bool element) {
+  int type = node->getType();
+
+  bool unary = (type == TT::TI_UN_NEG) || (type == TT::TI_UN_POS) ||
+               (type == TT::TI_UN_NOT) || (type == TT::TI_UN_BNOT);
+
+  for (RefPortugolAST c = node->getFirstChild(); c != antlr::nullAST;
+       c = c->getNextSibling()) {
+    fold(c, unary);
+  }
+
+  if (isCanonical(node)) {
+    return;
+  }
+
+  Constant v, left, right;
+  if (unary || (type == TT::TI_PARENTHESIS)) {
+    if (getConstant(node->getFirstChild(), v) && foldUnary(node, v) &&
+        setConstant(node, v, element)) {
+      return;
+    }
+  } else if (node->getNumberOfChildren() == 2) {
+    RefPortugolAST l = node->getFirstChild();
+    RefPortugolAST r = l->getNextSibling();
+    if (getConstant(l, left) && getConstant(r, right) &&
+        foldBinary(node, left, right, v) && setConstant(node, v, element)) {
+      return;
+    }
+  }
+  simplify(node);
+}
+
+// literais e numeros negativos ja na forma produzida por setConstant
+bool ASTOptimizer::isCanonical(RefPortugolAST node) {
+  switch (node->getType()) {
+  case TT::TI_UN_NEG:
+    return isNumberLiteral(node->getFirstChild());
+  case TT::TI_PARENTHESIS: {
+    RefPortugolAST c = node->getFirstChild();
+    return (c->getType() == TT::TI_UN_NEG) &&
+           isNumberLiteral(c->getFirstChild());
+  }
+  default:
+    return false;
+  }
+}
+
+bool ASTOptimizer::isNumberLiteral(RefPortugolAST node) {
+  return (node->getType() == TT::T_INT_LIT) ||
+         (node->getType() == TT::T_REAL_LIT);
+}
+
+bool ASTOptimizer::foldBinary(RefPortugolAST node, Constant &l, Constant &r,
+                              Constant &v) {
+  int op = node->getType();
+
+  switch (op) {
+  case TT::T_MAIS:
+  case TT::T_MENOS:
+  case TT::T_MULTIP:
+  case TT::T_DIV:
+    if (!isNumber(l.type) || !isNumber(r.type)) {
+      return false;
+    }
+    if ((l.type == TIPO_INTEIRO) && (r.type == TIPO_INTEIRO)) {
+      // aritmetica de 32 bits com complemento de 2, como nos back-ends
+      unsigned a = l.i, b = r.i;
+      v.type = TIPO_INTEIRO;
+      if (op == TT::T_MAIS) {
+        v.i = (int)(a + b);
+      } else if (op == TT::T_MENOS) {
+        v.i = (int)(a - b);
+      } else if (op == TT::T_MULTIP) {
+        v.i = (int)(a * b);
+      } else {
+        if ((r.i == 0) || ((l.i == INT_MIN) && (r.i == -1))) {
+          return false; // erro em tempo de execucao
+        }
+        v.i = l.i / r.i;
+      }
+    } else {
+      float a = (l.type == TIPO_REAL) ? l.r : (float)l.i;
+      float b = (r.type == TIPO_REAL) ? r.r : (float)r.i;
+      v.type = TIPO_REAL;
+      if (op == TT::T_MAIS) {
+        v.r = a + b;
+      } else if (op == TT::T_MENOS) {
+        v.r = a - b;
+      } else if (op == TT::T_MULTIP) {
+        v.r = a * b;
+      } else {
+        if (b == 0) {
+          return false; // erro em tempo de execucao
+        }
+        v.r = a / b;
+      }
+    }
+    return true;
+
+  case TT::T_MOD:
+  case TT::T_BIT_OU:
+  case TT::T_BIT_XOU:
+  case TT::T_BIT_E:
+    if ((l.type != TIPO_INTEIRO) || (r.type != TIPO_INTEIRO)) {
+      return false;
+    }
+    v.type = TIPO_INTEIRO;
+    if (op == TT::T_MOD) {
+      if ((r.i == 0) || ((l.i == INT_MIN) && (r.i == -1))) {
+        return false;
+      }
+      v.i = l.i % r.i;
+    } else if (op == TT::T_BIT_OU) {
+      v.i = l.i | r.i;
+    } else if (op == TT::T_BIT_XOU) {
+      v.i = l.i ^ r.i;
+    } else {
+      v.i = l.i & r.i;
+    }
+    return true;
+
+  case TT::T_KW_E:
+  case TT::T_KW_OU:
+    if (!isIntClass(l.type) || !isIntClass(r.type)) {
+      return false;
+    }
+    v.type = TIPO_LOGICO;
+    if (op == TT::T_KW_E) {
+      v.i = (l.i != 0) && (r.i != 0);
+    } else {
+      v.i = (l.i != 0) || (r.i != 0);
+    }
+    return true;
+
+  case TT::T_IGUAL:
+  case TT::T_DIFERENTE:
+  case TT::T_MAIOR:
+  case TT::T_MENOR:
+  case TT::T_MAIOR_EQ:
+  case TT::T_MENOR_EQ: {
+    // -1, 0 ou 1
+    int cmp;
+    if ((l.type == TIPO_LITERAL) && (r.type == TIPO_LITERAL)) {
+      if ((op == TT::T_IGUAL) || (op == TT::T_DIFERENTE)) {
+        cmp = (l.lit == r.lit) ? 0 : 1;
+      } else { // literais sao comparados pelo tamanho
+        cmp = (l.lit.length() < r.lit.length())
+                  ? -1
+                  : (l.lit.length() > r.lit.length());
+      }
+    } else if (isIntClass(l.type) && isIntClass(r.type)) {
+      cmp = (l.i < r.i) ? -1 : (l.i > r.i);
+    } else if (isNumber(l.type) && isNumber(r.type)) {
+      float a = (l.type == TIPO_REAL) ? l.r : (float)l.i;
+      float b = (r.type == TIPO_REAL) ? r.r : (float)r.i;
+      cmp = (a < b) ? -1 : (a > b);
+    } else {
+      return false;
+    }
+
+    v.type = TIPO_LOGICO;
+    switch (op) {
+    case TT::T_IGUAL:
+      v.i = (cmp == 0);
+      break;
+    case TT::T_DIFERENTE:
+      v.i = (cmp != 0);
+      break;
+    case TT::T_MAIOR:
+      v.i = (cmp > 0);
+      break;
+    case TT::T_MENOR:
+      v.i = (cmp < 0);
+      break;
+    case TT::T_MAIOR_EQ:
+      v.i = (cmp >= 0);
+      break;
+    default: // T_MENOR_EQ
+      v.i = (cmp <= 0);
+    }
+    return true;
+  }
+  }
+  return false;
+}
+
+bool ASTOptimizer::foldUnary(RefPortugolAST node, Constant &v) {
+  switch (node->getType()) {
+  case TT::TI_PARENTHESIS:
+    return true;
+  case TT::TI_UN_POS:
+    return isNumber(v.type);
+  case TT::TI_UN_NEG:
+    if (v.type == TIPO_INTEIRO) {
+      v.i = (int)(0u - (unsigned)v.i);
+      return true;
+    }
+    if (v.type == TIPO_REAL) {
+      v.r = -v.r;
+      return true;
+    }
+    return false;
+  case TT::TI_UN_NOT:
+    if (v.type != TIPO_LOGICO) {
+      return false;
+    }
+    v.i = !v.i;
+    return true;
+  case TT::TI_UN_BNOT:
+    if (v.type != TIPO_INTEIRO) {
+      return false;
+    }
+    v.i = ~v.i;
+    return true;
+  }
+  return false;
+}
+
+// identidades: x + 0, 0 + x, x - 0, x * 1, 1 * x, x / 1 e nao (nao x).
+// So' se aplicam quando x tem o mesmo tipo da expressao, para nao alterar
+// promocoes (ex: inteiro * 1.0 continua real).
+void ASTOptimizer::simplify(RefPortugolAST node) {
+  int op = node->getType();
+  int type = node->getEvalType();
+
+  if (op == TT::TI_UN_NOT) {
+    RefPortugolAST par = node->getFirstChild();
+    if ((par->getType() == TT::TI_PARENTHESIS) &&
+        (par->getFirstChild()->getType() == TT::TI_UN_NOT)) {
+      RefPortugolAST x = par->getFirstChild()->getFirstChild();
+      if (x->getEvalType() == TIPO_LOGICO) {
+        replace(node, x);
+      }
+    }
+    return;
+  }
+
+  if (node->getNumberOfChildren() != 2) {
+    return;
+  }
+
+  RefPortugolAST l = node->getFirstChild();
+  RefPortugolAST r = l->getNextSibling();
+  Constant c;
+
+  // e/ou com o operando esquerdo constante: com a avaliacao em
+  // curto-circuito, o direito so e' avaliado quando decide o resultado
+  if (((op == TT::T_KW_E) || (op == TT::T_KW_OU)) && getConstant(l, c) &&
+      isIntClass(c.type)) {
+    bool e = (op == TT::T_KW_E);
+    if ((c.i != 0) != e) {
+      // "falso e x", "verdadeiro ou x"
+      Constant v;
+      v.type = TIPO_LOGICO;
+      v.i = !e;
+      setConstant(node, v, false);
+    } else if (r->getEvalType() == TIPO_LOGICO) {
+      // "verdadeiro e x", "falso ou x"
+      replace(node, r);
+    }
+    return;
+  }
+
+  // elemento neutro a direita
+  if (getConstant(r, c) && (l->getEvalType() == type)) {
+    if ((isNumber(c, 0) && ((op == TT::T_MAIS) || (op == TT::T_MENOS))) ||
+        (isNumber(c, 1) && ((op == TT::T_MULTIP) || (op == TT::T_DIV)))) {
+      replace(node, l);
+      return;
+    }
+  }
+
+  // elemento neutro a esquerda
+  if (getConstant(l, c) && (r->getEvalType() == type)) {
+    if ((isNumber(c, 0) && (op == TT::T_MAIS)) ||
+        (isNumber(c, 1) && (op == TT::T_MULTIP))) {
+      replace(node, r);
+    }
+  }
+}
+
+bool ASTOptimizer::getConstant(RefPortugolAST node, Constant &c) {
+  const string &text = node->getText();
+
+  switch (node->getType()) {
+  case TT::T_INT_LIT:
+    c.type = TIPO_INTEIRO;
+    c.i = atoi(text.c_str());
+    return true;
+  case TT::T_REAL_LIT:
+    c.type = TIPO_REAL;
+    c.r = (float)atof(text.c_str());
+    return true;
+  case TT::T_KW_VERDADEIRO:
+  case TT::T_KW_FALSO:
+    c.type = TIPO_LOGICO;
+    c.i = (node->getType() == TT::T_KW_VERDADEIRO);
+    return true;
+  case TT::T_CARAC_LIT:
+    // sequencias de escape ficam para os back-ends
+    if ((text.length() != 1) || (text[0] == '\\')) {
+      return false;
+    }
+    c.type = TIPO_CARACTERE;
+    c.i = (int)text[0];
+    return true;
+  case TT::T_STRING_LIT:
+    if (text.find('\\') != string::npos) {
+      return false;
+    }
+    c.type = TIPO_LITERAL;
+    c.lit = text;
+    return true;
+  case TT::TI_UN_NEG:
+    if (!isNumberLiteral(node->getFirstChild()) ||
+        !getConstant(node->getFirstChild(), c)) {
+      return false;
+    }
+    return foldUnary(node, c);
+  case TT::TI_PARENTHESIS:
+    return getConstant(node->getFirstChild(), c);
+  default:
+    return false;
+  }
+}
+
+// substitui a expressao em node pelo valor v. Numeros negativos sao
+// representados como "-literal", entre parenteses se node for operando de
+// um operador unario.
+bool ASTOptimizer::setConstant(RefPortugolAST node, const Constant &v,
+                               bool element) {
+  stringstream s;
+  int type;
+  bool negative = false;
+
+  switch (v.type) {
+  case TIPO_INTEIRO:
+    if (v.i == INT_MIN) {
+      return false; // sem literal positivo correspondente
+    }
+    negative = v.i < 0;
+    s << (negative ? -v.i : v.i);
+    type = TT::T_INT_LIT;
+    break;
+  case TIPO_REAL: {
+    if (!std::isfinite(v.r)) {
+      return false;
+    }
+    char buf[32];
+    negative = v.r < 0;
+    snprintf(buf, sizeof(buf), "%.9g", negative ? -v.r : v.r);
+    s << buf;
+    if (s.str().find_first_of(".e") == string::npos) {
+      s << ".0";
+    }
+    type = TT::T_REAL_LIT;
+    break;
+  }
+  case TIPO_LOGICO:
+    s << (v.i ? "verdadeiro" : "falso");
+    type = v.i ? TT::T_KW_VERDADEIRO : TT::T_KW_FALSO;
+    break;
+  default:
+    return false;
+  }
+
+  node->setSlot(false, -1);
+  if (!negative) {
+    node->setType(type);
+    node->setText(s.str());
+    node->setFirstChild(antlr::nullAST);
+    return true;
+  }
+
+  RefPortugolAST neg = node;
+  if (element) {
+    neg = newNode(node, TT::TI_UN_NEG, "-");
+    node->setType(TT::TI_PARENTHESIS);
+    node->setText("!par");
+    node->setFirstChild(neg);
+  } else {
+    node->setType(TT::TI_UN_NEG);
+    node->setText("-");
+  }
+  neg->setFirstChild(newNode(node, type, s.str()));
+  return true;
+}
+
+RefPortugolAST ASTOptimizer::newNode(RefPortugolAST model, int type,
+                                     const string &text) {
+  RefPortugolAST n(new PortugolAST());
+  n->setType(type);
+  n->setText(text);
+  n->setLine(model->getLine());
+  n->setFilename(model->getFilename());
+  n->setEvalType(model->getEvalType());
+  return n;
+}
+
+// copia other (e seus filhos) sobre node, mantendo os irmaos de node
+void ASTOptimizer::replace(RefPortugolAST node, RefPortugolAST other) {
+  node->setType(other->getType());
+  node->setText(other->getText());
+  node->setLine(other->getLine());
+  node->setFilename(other->getFilename());
+  node->setEvalType(other->getEvalType());
+  node->setSlot(other->isGlobalSlot(), other->getSlot());
+  node->setFirstChild(other->getFirstChild());
+}
+
+// numera os literais restantes, indice usado pelos interpretadores para
+// decodifica-los uma unica vez (ver PortugolAST::setSlot)
+void ASTOptimizer::numberLiterals(RefPortugolAST node) {
+  switch (node->getType()) {
+  case TT::T_STRING_LIT:
+  case TT::T_INT_LIT:
+  case TT::T_REAL_LIT:
+  case TT::T_CARAC_LIT:
+  case TT::T_KW_VERDADEIRO:
+  case TT::T_KW_FALSO:
+    node->setSlot(true, literals++);
+    break;
+  }
+  for (RefPortugolAST c = node->getFirstChild(); c != antlr::nullAST;
+       c = c->getNextSibling()) {
+    numberLiterals(c);
+  }
+}
@@ -0,0 +1,71 @@
+/***************************************************************************
+ *   Copyright (C) 2026 G-Portugol contributors                            *
+ *   gportugol@googlegroups.com                                            *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#ifndef ASTOPTIMIZER_HPP
+#define ASTOPTIMIZER_HPP
+
+#include "PortugolAST.hpp"
+
+#include <string>
+
+using namespace std;
+
+// otimizacoes sobre a arvore ja validada pela analise semantica,
+// compartilhadas por todos os back-ends (interpretador, x86 e C):
+// - avaliacao de subexpressoes constantes (2 * 3 + x => 6 + x)
+// - simplificacoes algebricas (x * 1, x + 0, nao nao x)
+// Divisoes por zero nao sao avaliadas, preservando o erro em tempo de
+// execucao.
+class ASTOptimizer {
+public:
+  // otimiza a arvore de "algoritmo" (node e seus irmaos)
+  void optimize(RefPortugolAST node);
+
+  // valor de uma expressao constante
+  struct Constant {
+    int type; // TIPO_INTEIRO, TIPO_REAL, TIPO_LOGICO, TIPO_CARACTERE ou
+              // TIPO_LITERAL
+    int i;    // inteiro, logico, caractere
+    float r;
+    string lit;
+  };
+
+private:
+  void fold(RefPortugolAST node, bool element);
+  bool foldBinary(RefPortugolAST node, Constant &left, Constant &right,
+                  Constant &v);
+  bool foldUnary(RefPortugolAST node, Constant &v);
+  void simplify(RefPortugolAST node);
+
+  bool isCanonical(RefPortugolAST node);
+  bool isNumberLiteral(RefPortugolAST node);
+
+  bool getConstant(RefPortugolAST node, Constant &c);
+  bool setConstant(RefPortugolAST node, const Constant &v, bool element);
+  RefPortugolAST newNode(RefPortugolAST model, int type, const string &text);
+  void replace(RefPortugolAST node, RefPortugolAST other);
+
+  void numberLiterals(RefPortugolAST node);
+
+  int literals; // literais numerados ate agora
+};
+
+#endif
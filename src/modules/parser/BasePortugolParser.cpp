@@ -50,13 +50,15 @@ string BasePortugolParser::expecting_param_or_fparen = "variável ou \")\"";
 
 BasePortugolParser::BasePortugolParser(const ParserSharedInputState &lexer,
                                        int k_)
-    : LLkParser(lexer, k) {}
+    : LLkParser(lexer, k), display(0) {}
 
 BasePortugolParser::BasePortugolParser(TokenBuffer &tokenBuf, int k_)
-    : LLkParser(tokenBuf, k) {}
+    : LLkParser(tokenBuf, k), display(0) {}
 
 BasePortugolParser::BasePortugolParser(TokenStream &lexer, int k_)
-    : LLkParser(lexer, k) {}
+    : LLkParser(lexer, k), display(0) {}
+
+void BasePortugolParser::setDisplay(GPTDisplay &d) { display = &d; }
 
 string BasePortugolParser::nomeAlgoritmo() { return _name; }
 
@@ -109,9 +111,9 @@ int BasePortugolParser::reportParserError(int line, string expecting,
 
   stringstream s;
   s << "Esperando " << expecting << str;
-  return GPTDisplay::self()->add(s.str(), line);
+  return display->add(s.str(), line);
 }
 
 void BasePortugolParser::printTip(const string &msg, int line, int cd) {
-  GPTDisplay::self()->addTip(msg, line, cd);
+  display->addTip(msg, line, cd);
 }
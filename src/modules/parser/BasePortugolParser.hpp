@@ -29,6 +29,8 @@
 
 #include "PortugolParserTokenTypes.hpp"
 
+class GPTDisplay;
+
 // #include "SymbolTable.hpp"
 
 using namespace std;
@@ -47,6 +49,9 @@ public:
 
   string nomeAlgoritmo();
 
+  // destino dos erros sintaticos (obrigatorio antes da analise)
+  void setDisplay(GPTDisplay &d);
+
 protected:
   static string expecting_algorithm_name;
   static string expecting_variable;
@@ -140,6 +145,8 @@ protected:
   string currentScope; // global,f1(),...
 
   string _name;
+
+  GPTDisplay *display;
 };
 
 #endif
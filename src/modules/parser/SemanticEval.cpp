@@ -181,7 +181,8 @@ string ExpressionValue::id() { return _id; }
 
 //******************************************************************************************//
 
-SemanticEval::SemanticEval(SymbolTable &st) : stable(st) {}
+SemanticEval::SemanticEval(SymbolTable &st, GPTDisplay &d)
+    : stable(st), display(d) {}
 
 SymbolTable &SemanticEval::getSymbolTable() { return stable; }
 
@@ -198,7 +199,7 @@ void SemanticEval::declareVar(int type, list<int> dims, RefPortugolAST mt) {
   for (list<int>::iterator itd = dims.begin(); itd != dims.end(); ++itd) {
     if ((*itd) == 0) {
       msg << "Dimensões de matrizes/conjuntos não podem ter tamanho 0";
-      GPTDisplay::self()->add(msg.str(), mt->getLine());
+      display.add(msg.str(), mt->getLine());
     }
   }
 
@@ -228,7 +229,7 @@ void SemanticEval::declareVars(
        itd != ms.first.second.end(); ++itd) {
     if ((*itd) == 0) {
       msg << "Dimensões de matrizes/conjuntos não podem ter tamanho 0";
-      GPTDisplay::self()->add(msg.str(), (*(ms.second.begin()))->getLine());
+      display.add(msg.str(), (*(ms.second.begin()))->getLine());
     }
   }
 
@@ -251,17 +252,17 @@ void SemanticEval::evaluateAttribution(ExpressionValue &lv, ExpressionValue &rv,
   if (!lv.isPrimitive()) {
     msg << "Faltando indicar subscrito da matriz/conjunto \"" << lv.id()
         << "\"";
-    GPTDisplay::self()->add(msg.str(), line);
+    display.add(msg.str(), line);
     return;
   }
 
   if (rv.primitiveType() == TIPO_NULO) {
     msg << "Expressão não retorna resultado para variável";
-    GPTDisplay::self()->add(msg.str(), line);
+    display.add(msg.str(), line);
   } else if (!lv.isCompatibleWidth(rv)) {
     msg << "Variável \"" << lv.id() << "\" não pode receber valores do tipo '"
         << rv.toString() << "'";
-    GPTDisplay::self()->add(msg.str(), line);
+    display.add(msg.str(), line);
   }
 }
 
@@ -289,7 +290,7 @@ ExpressionValue SemanticEval::evaluateLValue(RefPortugolAST id,
   } catch (SymbolTableException &e) {
     stringstream msg;
     msg << "Variável \"" << id->getText() << "\" não foi declarada";
-    GPTDisplay::self()->add(msg.str(), id->getLine());
+    display.add(msg.str(), id->getLine());
     return ret;
   }
 
@@ -298,16 +299,18 @@ ExpressionValue SemanticEval::evaluateLValue(RefPortugolAST id,
   if (lvalue.isFunction) {
     stringstream msg;
     msg << "Faltando abrir parêntesis após função \"" << id->getText() << "\"";
-    GPTDisplay::self()->add(msg.str(), id->getLine());
+    display.add(msg.str(), id->getLine());
     return ret;
   }
 
+  id->setSlot(!islocal, lvalue.slot);
+
   if (lvalue.type.isPrimitive()) {
     ret.set(lvalue.type);
     if (dim.size() > 0) {
       stringstream msg;
       msg << "Variável \"" << id->getText() << "\" não é uma matriz/conjunto";
-      GPTDisplay::self()->add(msg.str(), id->getLine());
+      display.add(msg.str(), id->getLine());
       return ret;
     } else {
       return ret;
@@ -324,7 +327,7 @@ ExpressionValue SemanticEval::evaluateLValue(RefPortugolAST id,
         stringstream msg;
         msg << "Subscritos da matriz/conjunto \"" << id->getText()
             << "\" devem ser valores numéricos inteiros ou equivalente";
-        GPTDisplay::self()->add(msg.str(), id->getLine());
+        display.add(msg.str(), id->getLine());
       }
     }
 
@@ -352,7 +355,7 @@ ExpressionValue SemanticEval::evaluateLValue(RefPortugolAST id,
           msg << " dimensões";
         }
         msg << ". Use " << lvalue.type.dimensions().size() << " subscrito(s)";
-        GPTDisplay::self()->add(msg.str(), id->getLine());
+        display.add(msg.str(), id->getLine());
       }
     } else {
       // variavel matriz sem subscritos, retorna tipo matriz
@@ -373,16 +376,16 @@ void SemanticEval::evaluateParaExpr(ExpressionValue &ev, int line,
   if (!ev.isPrimitive()) {
     err << "Faltando indicar subscritos da matriz/conjunto \"" << ev.id()
         << "\"";
-    GPTDisplay::self()->add(err.str(), line);
+    display.add(err.str(), line);
   } else {
     if (ev.primitiveType() != TIPO_INTEIRO) {
       err << "Expressão \"" << term << "\" deve ser do tipo inteiro";
-      GPTDisplay::self()->add(err.str(), line);
+      display.add(err.str(), line);
     }
   } /*else if(!ev.isNumeric()) {
     stringstream err;
     err << "Esperando uma expressão numérica. Encontrado expressão \"" <<
-  ev.toString() << "\""; GPTDisplay::self()->add(err.str(), line);
+  ev.toString() << "\""; display.add(err.str(), line);
   }*/
 }
 
@@ -403,7 +406,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &left,
       (right.primitiveType() == TIPO_ALL)) {
     stringstream msg;
     msg << "Função interna \"leia\" não pode participar de expressão";
-    GPTDisplay::self()->add(msg.str(), op->getLine());
+    display.add(msg.str(), op->getLine());
     return nulo;
   }
 
@@ -430,7 +433,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &left,
           << "\" não pode ser usado em expressões no formato "
           << "'" << left.toString() << " " << op->getText() << " "
           << right.toString() << "'";
-      GPTDisplay::self()->add(msg.str(), op->getLine());
+      display.add(msg.str(), op->getLine());
       return nulo;
     }
     break;
@@ -445,7 +448,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &left,
       stringstream msg;
       msg << "Operador \"" << op->getText()
           << "\" só pode ser usado com termos númericos não-reais";
-      GPTDisplay::self()->add(msg.str(), op->getLine());
+      display.add(msg.str(), op->getLine());
       return nulo;
     } else {
       return ret;
@@ -462,7 +465,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &left,
       stringstream msg;
       msg << "Operador \"" << op->getText()
           << "\" só pode ser usado com termos numéricos";
-      GPTDisplay::self()->add(msg.str(), op->getLine());
+      display.add(msg.str(), op->getLine());
       return nulo;
     } else {
       return ret;
@@ -475,7 +478,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &left,
       msg << "Operador \"" << op->getText()
           << "\" só pode ser usado com termos "
           << "numéricos inteiros e compatíveis";
-      GPTDisplay::self()->add(msg.str(), op->getLine());
+      display.add(msg.str(), op->getLine());
       return nulo;
     } else {
       return ret;
@@ -485,7 +488,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &left,
 
   stringstream msg;
   msg << "Erro interno: operador não suportado: " << op->getText();
-  GPTDisplay::self()->add(msg.str(), op->getLine());
+  display.add(msg.str(), op->getLine());
   return nulo;
 }
 
@@ -497,7 +500,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &ev,
   if (ev.primitiveType() == TIPO_ALL) {
     stringstream msg;
     msg << "Função interna \"leia\" não pode participar de expressão";
-    GPTDisplay::self()->add(msg.str(), unary_op->getLine());
+    display.add(msg.str(), unary_op->getLine());
     return nulo;
   }
 
@@ -511,7 +514,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &ev,
       stringstream msg;
       msg << "Operador unário \"" << unary_op->getText()
           << "\" deve ser usado em termos numéricos";
-      GPTDisplay::self()->add(msg.str(), unary_op->getLine());
+      display.add(msg.str(), unary_op->getLine());
       return nulo;
     } else {
       return ev;
@@ -522,7 +525,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &ev,
       stringstream msg;
       msg << "Operador unário \"" << unary_op->getText()
           << "\" deve ser usado em termos numéricos inteiros e compatíveis";
-      GPTDisplay::self()->add(msg.str(), unary_op->getLine());
+      display.add(msg.str(), unary_op->getLine());
       return nulo;
     } else {
       return ev;
@@ -538,7 +541,7 @@ ExpressionValue SemanticEval::evaluateExpr(ExpressionValue &ev,
 
   stringstream msg;
   msg << "Erro interno: operador não suportado: " << unary_op->getText() << "";
-  GPTDisplay::self()->add(msg.str(), unary_op->getLine());
+  display.add(msg.str(), unary_op->getLine());
   return nulo;
 }
 
@@ -549,7 +552,7 @@ void SemanticEval::evaluateReturnCmd(ExpressionValue &ev, int line) {
       stringstream msg;
       msg << "Valor de retorno do bloco principal deve ser compatível com o "
              "tipo inteiro";
-      GPTDisplay::self()->add(msg.str(), line);
+      display.add(msg.str(), line);
     }
   } else {
     // currentScope eh o nome da funcao atual
@@ -565,7 +568,7 @@ void SemanticEval::evaluateReturnCmd(ExpressionValue &ev, int line) {
           msg << "Expressão de retorno deve ser compatível com o tipo \""
               << sctype.toString() << "\"";
         }
-        GPTDisplay::self()->add(msg.str(), line);
+        display.add(msg.str(), line);
       } // else ok!
     } catch (SymbolTableException &e) {
       cerr << "Erro interno: SemanticEval::evaluateReturnCmd exception\n";
@@ -613,7 +616,7 @@ void SemanticEval::declareFunction(Funcao &f) {
 //   } catch(SymbolTableException& e) {
 //       stringstream msg;
 //       msg << "Função \"" << f->getText() << "\" não foi declarada";
-//       GPTDisplay::self()->add(msg.str(), f->getLine());
+//       display.add(msg.str(), f->getLine());
 //   }
 //
 //   return v;
@@ -626,10 +629,11 @@ ExpressionValue SemanticEval::evaluateFCall(RefPortugolAST f,
   try {
     s = stable.getSymbol(SymbolTable::GlobalScope, f->getText());
     v.set(s.type);
+    f->setSlot(true, s.slot);
   } catch (SymbolTableException &e) {
     stringstream msg;
     msg << "Função \"" << f->getText() << "\" não foi declarada";
-    GPTDisplay::self()->add(msg.str(), f->getLine());
+    display.add(msg.str(), f->getLine());
     return v;
   }
 
@@ -641,7 +645,7 @@ ExpressionValue SemanticEval::evaluateFCall(RefPortugolAST f,
       stringstream msg;
       msg << "Pelo menos um argumento deve ser passado para a função \""
           << f->getText() << "\"";
-      GPTDisplay::self()->add(msg.str(), f->getLine());
+      display.add(msg.str(), f->getLine());
       return v;
     }
     // nao permitir matrizes como argumentos de funcoes com parametros variaveis
@@ -653,7 +657,7 @@ ExpressionValue SemanticEval::evaluateFCall(RefPortugolAST f,
         msg << "Argumento " << count;
         msg << " da função \"" << f->getText()
             << "\" não pode ser matriz/conjunto";
-        GPTDisplay::self()->add(msg.str(), f->getLine());
+        display.add(msg.str(), f->getLine());
         return v;
       }
       count++;
@@ -665,7 +669,7 @@ ExpressionValue SemanticEval::evaluateFCall(RefPortugolAST f,
     stringstream msg;
     msg << "Número de argumentos diferem do número de parâmetros da função \""
         << f->getText() << "\"";
-    GPTDisplay::self()->add(msg.str(), f->getLine());
+    display.add(msg.str(), f->getLine());
     return v;
   }
 
@@ -681,7 +685,7 @@ ExpressionValue SemanticEval::evaluateFCall(RefPortugolAST f,
       stringstream msg;
       msg << "Argumento " << count << " da função \"" << f->getText()
           << "\" deve ser do tipo \"" << (*pit).second.toString() << "\"";
-      GPTDisplay::self()->add(msg.str(), f->getLine());
+      display.add(msg.str(), f->getLine());
       return v;
     }
     ++count;
@@ -695,8 +699,76 @@ void SemanticEval::evaluatePasso(int line, const string &str) {
   if (atoi(str.c_str()) == 0) {
     stringstream msg;
     msg << "Passo com valor \"0\" não é permitido";
-    GPTDisplay::self()->add(msg.str(), line);
+    display.add(msg.str(), line);
+  }
+}
+
+// variaveis lidas por uma expressao (global, slot); calls indica se ela
+// chama alguma funcao
+static void collectReads(RefPortugolAST node, set<pair<bool, int>> &vars,
+                         bool &calls) {
+  if (node->getType() == SemanticWalkerTokenTypes::TI_FCALL) {
+    calls = true;
+    return;
+  }
+  if (node->getType() == SemanticWalkerTokenTypes::T_IDENTIFICADOR) {
+    vars.insert(make_pair(node->isGlobalSlot(), node->getSlot()));
+  }
+  for (RefPortugolAST c = node->getFirstChild(); c != antlr::nullAST;
+       c = c->getNextSibling()) {
+    collectReads(c, vars, calls);
+  }
+}
+
+// variaveis alteradas por comandos (atribuicoes e variaveis de controle de
+// "para"); calls indica se ha chamadas a funcoes do usuario, que podem
+// alterar variaveis globais
+void SemanticEval::collectWrites(RefPortugolAST node,
+                                 set<pair<bool, int>> &vars, bool &calls) {
+  RefPortugolAST target;
+  switch (node->getType()) {
+  case SemanticWalkerTokenTypes::T_ATTR:
+  case SemanticWalkerTokenTypes::T_KW_PARA:
+    target = node->getFirstChild();
+    vars.insert(make_pair(target->isGlobalSlot(), target->getSlot()));
+    break;
+  case SemanticWalkerTokenTypes::TI_FCALL:
+    try {
+      calls = calls || !stable.getSymbol(SymbolTable::GlobalScope,
+                                         node->getFirstChild()->getText())
+                             .isBuiltin;
+    } catch (SymbolTableException &e) {
+      calls = true;
+    }
+    break;
+  }
+  for (RefPortugolAST c = node->getFirstChild(); c != antlr::nullAST;
+       c = c->getNextSibling()) {
+    collectWrites(c, vars, calls);
+  }
+}
+
+// o limite ("ate") de um "para" e' invariante se nao chama funcoes e
+// nenhuma variavel que ele le e' alterada no laco
+void SemanticEval::evaluateParaBound(RefPortugolAST para) {
+  RefPortugolAST ate =
+      para->getFirstChild()->getNextSibling()->getNextSibling();
+
+  set<pair<bool, int>> reads;
+  bool readCalls = false;
+  collectReads(ate, reads, readCalls);
+
+  set<pair<bool, int>> writes;
+  bool writeCalls = false;
+  collectWrites(para, writes, writeCalls);
+
+  bool invariant = !readCalls;
+  for (set<pair<bool, int>>::iterator it = reads.begin();
+       invariant && (it != reads.end()); ++it) {
+    invariant = (writes.find(*it) == writes.end()) &&
+                !(writeCalls && it->first);
   }
+  para->setInvariantBound(invariant);
 }
 
 /************************************** Protected
@@ -713,7 +785,7 @@ bool SemanticEval::evalVariableRedeclaration(const string &scope,
     // err << "Variável/função redeclarada: \"" << id->getText() << "\".
     // Primeira declaração na linha "
     //     << s.line;
-    GPTDisplay::self()->add(err.str(), id->getLine());
+    display.add(err.str(), id->getLine());
     return true;
   } catch (SymbolTableException &e) {
     return false;
@@ -21,11 +21,13 @@
 #ifndef SEMANTICEVAL_HPP
 #define SEMANTICEVAL_HPP
 
+#include "GPTDisplay.hpp"
 #include "PortugolAST.hpp"
 #include "SymbolTable.hpp"
 
 #include <list>
 #include <map>
+#include <set>
 #include <stdlib.h>
 #include <string>
 
@@ -108,7 +110,7 @@ public:
 
 class SemanticEval {
 public:
-  SemanticEval(SymbolTable &st);
+  SemanticEval(SymbolTable &st, GPTDisplay &d);
 
   SymbolTable &getSymbolTable();
 
@@ -137,14 +139,18 @@ public:
   //   void evaluateAllFCalls();
 
   void evaluatePasso(int line, const string &str);
+  void evaluateParaBound(RefPortugolAST para);
 
 protected:
   bool evalVariableRedeclaration(const string &scope, RefPortugolAST id);
+  void collectWrites(RefPortugolAST node, set<pair<bool, int>> &vars,
+                     bool &calls);
 
   ExpressionValue evaluateNumTypes(ExpressionValue &left,
                                    ExpressionValue &right);
 
   SymbolTable &stable;
+  GPTDisplay &display;
   string currentScope;
   list<pair<RefPortugolAST, list<ExpressionValue>>> fcallsList;
 };
@@ -21,11 +21,11 @@
 
 header {
   #include "GPTDisplay.hpp"
+  #include "PortugolToken.hpp"
   #include <string>
   #include <sstream>
   #include <iostream>
   #include <ctype.h>
-  #include <antlr/TokenStreamSelector.hpp>
 	#include "UnicodeCharBuffer.hpp"
 	#include "UnicodeCharScanner.hpp"
   #include <stdlib.h>
@@ -109,29 +109,26 @@ tokens {
 
 {
 public:
-  PortugolLexer(ANTLR_USE_NAMESPACE(std)istream& in, TokenStreamSelector* s)
+  // um lexer por arquivo; erros vao para d
+  PortugolLexer(ANTLR_USE_NAMESPACE(std)istream& in, GPTDisplay& d)
 	: UnicodeCharScanner(new UnicodeCharBuffer(in),true),
-    selector(s)
+    display(d)
   {
+    setTokenObjectFactory(&PortugolToken::factory);
     initLiterals();
   }
 
-  void uponEOF()
+protected:
+  // cada token leva o nome do arquivo (setFilename) para a AST
+  RefToken makeToken(int t)
   {
-    if(!nextFilename.empty()) {
-      GPTDisplay::self()->setCurrentFile(nextFilename);
-      selector->pop();
-      selector->retry();
-    }
-  }
-
-  void setNextFilename(string str) {
-    nextFilename = str;
+    RefToken tk = UnicodeCharScanner::makeToken(t);
+    static_cast<PortugolToken*>(tk.get())->setSourceFile(getFilename());
+    return tk;
   }
 
 private:
-  string nextFilename;
-  TokenStreamSelector* selector;
+  GPTDisplay& display;
   bool hasLatim;
 }
 /*------------------------- Operators -----------------------*/
@@ -301,14 +298,14 @@ T_OCTAL_LIT
            (str.find("9",0) != string::npos) ) {
           stringstream s;
           s << "\"" << $getText << "\" não é um valor octal válido";
-          GPTDisplay::self()->add(s.str(), getLine());
+          display.add(s.str(), getLine());
           haserror = true;
         } else {
           for(unsigned int i = 2; i < str.length(); ++i) {
             if(!isdigit(str[i])) {
               stringstream s;
               s << "\"" << str << "\" não é um valor hexadecimal válido";
-              GPTDisplay::self()->add(s.str(), getLine());
+              display.add(s.str(), getLine());
               haserror = true;
               break;
             }
@@ -338,7 +335,7 @@ T_HEX_LIT
         if(!isxdigit(str[i])) {
           stringstream s;
           s << "\"" << str << "\" não é um valor hexadecimal válido";
-          GPTDisplay::self()->add(s.str(), getLine());
+          display.add(s.str(), getLine());
           haserror = true;
           break;
         }
@@ -366,7 +363,7 @@ T_BIN_LIT
       if((str[i] != '0') && (str[i] != '1')) {
         stringstream s;
         s << "\"" << str << "\" não é um valor binário válido";
-        GPTDisplay::self()->add(s.str(), getLine());
+        display.add(s.str(), getLine());
         haserror = true;
         break;
       }
@@ -471,7 +468,7 @@ exception
 catch[antlr::RecognitionException] {
   stringstream s;
   s << "AVISO: comentário iniciado na linha " << line << " não termina com \"*/\".";
-  GPTDisplay::self()->add(s.str(), getLine());
+  display.add(s.str(), getLine());
 
   _ttype = antlr::Token::SKIP;
 }
@@ -549,7 +546,7 @@ options {
     if(hasLatim && (testLiteralsTable(_ttype) == T_IDENTIFICADOR)) {
       stringstream s;
       s << "Identificador \"" << $getText << "\" não pode ter caracteres especiais.";
-      GPTDisplay::self()->add(s.str(), getLine());
+      display.add(s.str(), getLine());
     }
   }
   ;
@@ -582,7 +579,7 @@ T_INVALID
         } else {
           s << "Faltando fechar aspas";
         }
-        GPTDisplay::self()->add(s.str(), getLine());
+        display.add(s.str(), getLine());
       }
     }
   ;
@@ -60,6 +60,18 @@ algoritmo
     reportParserError(e.getLine(), expecting_eof_or_function, getTokenDescription(e.token));
   }
 
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//arquivos incluidos (lib/base.gpt, GPT_INCLUDE): apenas funcoes. A AST resultante
+//e' anexada a do algoritmo (ver CompiledProgram::parse)
+biblioteca
+  : (func_decls)* EOF
+  ;
+
+  exception
+  catch[antlr::MismatchedTokenException e] { //EOF
+    reportParserError(e.getLine(), expecting_eof_or_function, getTokenDescription(e.token));
+  }
+
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 declaracao_algoritmo
   : alg:T_KW_ALGORITMO^ id:T_IDENTIFICADOR T_SEMICOL!
@@ -827,7 +839,7 @@ fcall!
       {
         #fcall = #([TI_FCALL,"fcall!"], id, a);
         #fcall->setLine(id->getLine());
-        #fcall->setFilename(GPTDisplay::self()->getCurrentFile());
+        #fcall->setFilename(#id->getFilename());
       }
   ;
 
@@ -44,11 +44,12 @@ options {
 
 {
   public:
-    SemanticWalker(SymbolTable& st)
-      : evaluator(st) {
+    SemanticWalker(SymbolTable& st, GPTDisplay& d)
+      : display(d), evaluator(st, d) {
     }
 
   private:
+    GPTDisplay& display;
     SemanticEval evaluator;
 }
 
@@ -57,7 +58,7 @@ options {
 algoritmo
 {
   RefPortugolAST inicio_;
-  GPTDisplay::self()->setCurrentFile(_t->getFilename());
+  display.setCurrentFile(_t->getFilename());
 }
   : {
       _t = _t->getNextSibling(); //pula declaracao de algoritmo
@@ -265,6 +266,7 @@ stm_para
         ate=expr  {evaluator.evaluateParaExpr(ate, p->getLine(), "até");}
         (passo)? (stm)*
     )
+    {evaluator.evaluateParaBound(p);}
   ;
 
 passo
@@ -300,10 +302,13 @@ expr returns [ExpressionValue type]
 
 
 element returns [ExpressionValue type]
-  : type=literal
-  | type=fcall
-  | type=lvalue
-  | #(TI_PARENTHESIS type=expr)
+  : (
+      type=literal
+    | type=fcall
+    | type=lvalue
+    | #(TI_PARENTHESIS type=expr)
+    )
+    {#element->setEvalType(type.primitiveType());} //operandos de unarios
   ;
 
 literal returns [ExpressionValue type]
@@ -344,7 +349,7 @@ func_decl
 {
   pair<int, list<RefPortugolAST> > argsp;
   pair< pair<int, list<int> >, list<RefPortugolAST> > argsm;
-  GPTDisplay::self()->setCurrentFile(_t->getFilename());
+  display.setCurrentFile(_t->getFilename());
 }
   : #(id:T_IDENTIFICADOR
       {
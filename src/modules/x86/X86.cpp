@@ -146,7 +146,7 @@ string X86::EntryPoint = "start";
 
 string X86::makeID(const string &str) { return string("_") + str; }
 
-X86::X86(SymbolTable &st) : _stable(st) {}
+X86::X86(SymbolTable &st) : _stable(st), _labels(0) {}
 
 X86::~X86() {}
 
@@ -217,7 +217,7 @@ void X86::declarePrimitive(int decl_type, const string &name, int type) {
       writeDATA(s.str());
       break;
     default:
-      GPTDisplay::self()->showError(
+      GPTDisplay::showError(
           "Erro interno: tipo nao suportado (X86::declarePrimitive).");
       exit(1);
     }
@@ -226,7 +226,7 @@ void X86::declarePrimitive(int decl_type, const string &name, int type) {
   } else if (decl_type == VAR_LOCAL) {
     _subprograms[currentScope()].declareLocal(name);
   } else {
-    GPTDisplay::self()->showError("Erro interno: X86::declarePrimitive).");
+    GPTDisplay::showError("Erro interno: X86::declarePrimitive).");
     exit(1);
   }
 }
@@ -249,7 +249,7 @@ void X86::declareMatrix(int decl_type, int type, string name,
       s << X86::makeID(name) << " times " << size << " dd 0";
       break;
     default:
-      GPTDisplay::self()->showError(
+      GPTDisplay::showError(
           "Erro interno: tipo nao suportado (X86::declarePrimitive).");
       exit(1);
     }
@@ -259,7 +259,7 @@ void X86::declareMatrix(int decl_type, int type, string name,
   } else if (decl_type == VAR_LOCAL) {
     _subprograms[currentScope()].declareLocal(name, size);
   } else {
-    GPTDisplay::self()->showError("Erro interno: X86::declareMatrix).");
+    GPTDisplay::showError("Erro interno: X86::declareMatrix).");
     exit(1);
   }
 }
@@ -314,7 +314,7 @@ string X86::translateFuncLeia(const string &id, int type) {
   case TIPO_INTEIRO:
     return "leia_inteiro";
   default:
-    GPTDisplay::self()->showError(
+    GPTDisplay::showError(
         "Erro interno: tipo nao suportado (x86::translateFuncLeia).");
     exit(1);
   }
@@ -333,21 +333,20 @@ string X86::translateFuncImprima(const string &id, int type) {
   case TIPO_INTEIRO:
     return "imprima_inteiro";
   default:
-    GPTDisplay::self()->showError(
+    GPTDisplay::showError(
         "Erro interno: tipo nao suportado (x86::translateFuncImprima).");
     exit(1);
   }
 }
 
 string X86::createLabel(bool local, string tmpl) {
-  static int c = 0;
   stringstream s;
   if (local) {
-    s << ".__" << tmpl << "_" << c;
+    s << ".__" << tmpl << "_" << _labels;
   } else {
-    s << "__" << tmpl << "_" << c;
+    s << "__" << tmpl << "_" << _labels;
   }
-  c++;
+  _labels++;
   return s.str();
 }
 
@@ -423,34 +422,40 @@ void X86::writeAttribution(int e1, int e2, pair<pair<int, bool>, string> &lv) {
   writeTEXT(s.str());
 }
 
-void X86::writeOuExpr() {
-  writeTEXT("pop ebx");
+// operando esquerdo de "ou": se verdadeiro, ja e' o resultado
+void X86::writeOuExpr(const string &lbfim) {
   writeTEXT("pop eax");
 
   writeTEXT("cmp eax, 0");
   writeTEXT("setne al");
   writeTEXT("and eax, 0xff");
-  writeTEXT("cmp ebx, 0");
-  writeTEXT("setne bl");
-  writeTEXT("and ebx, 0xff");
-  writeTEXT("or al, bl");
+  writeTEXT("push eax");
+  writeTEXT("jnz near " + lbfim);
+  writeTEXT("add esp, 4");
+}
+
+// operando esquerdo de "e": se falso, ja e' o resultado
+void X86::writeEExpr(const string &lbfim) {
+  writeTEXT("pop eax");
 
+  writeTEXT("cmp eax, 0");
+  writeTEXT("setne al");
+  writeTEXT("and eax, 0xff");
   writeTEXT("push eax");
+  writeTEXT("jz near " + lbfim);
+  writeTEXT("add esp, 4");
 }
 
-void X86::writeEExpr() {
-  writeTEXT("pop ebx");
+// operando direito de "e"/"ou": decide o resultado
+void X86::writeLogicExprEnd(const string &lbfim) {
   writeTEXT("pop eax");
 
   writeTEXT("cmp eax, 0");
   writeTEXT("setne al");
   writeTEXT("and eax, 0xff");
-  writeTEXT("cmp ebx, 0");
-  writeTEXT("setne bl");
-  writeTEXT("and ebx, 0xff");
-  writeTEXT("and al, bl");
 
   writeTEXT("push eax");
+  writeTEXT(lbfim + ":");
 }
 
 void X86::writeBitOuExpr() {
@@ -93,8 +93,9 @@ public:
   void writeExit();
 
   void writeAttribution(int e1, int e2, pair<pair<int, bool>, string> &);
-  void writeOuExpr();
-  void writeEExpr();
+  void writeOuExpr(const string &lbfim);
+  void writeEExpr(const string &lbfim);
+  void writeLogicExprEnd(const string &lbfim);
   void writeBitOuExpr();
   void writeBitXouExpr();
   void writeBitEExpr();
@@ -127,6 +128,8 @@ private:
 
   string _currentScope;
 
+  int _labels; // contador de createLabel
+
   stringstream _head;
   stringstream _bss;
   stringstream _data;
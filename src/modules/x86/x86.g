@@ -634,15 +634,26 @@ expr[int expecting_type] returns [int etype]
 {
   int e1, e2;
   stringstream s;
+  string lbfim; //e/ou: o operando direito so e' avaliado se necessario
   etype = #expr->getEvalType();
 }
-  : #(T_KW_OU     e1=expr[expecting_type] e2=expr[expecting_type])
+  : #(T_KW_OU     e1=expr[expecting_type]
       {
-        x86.writeOuExpr();
+        lbfim = x86.createLabel(true, "fim_ou");
+        x86.writeOuExpr(lbfim);
       }
-  | #(T_KW_E      e1=expr[expecting_type] e2=expr[expecting_type])
+      e2=expr[expecting_type])
       {
-        x86.writeEExpr();
+        x86.writeLogicExprEnd(lbfim);
+      }
+  | #(T_KW_E      e1=expr[expecting_type]
+      {
+        lbfim = x86.createLabel(true, "fim_e");
+        x86.writeEExpr(lbfim);
+      }
+      e2=expr[expecting_type])
+      {
+        x86.writeLogicExprEnd(lbfim);
       }
   | #(T_BIT_OU    e1=expr[expecting_type] e2=expr[expecting_type])
       {
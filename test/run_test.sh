@@ -38,11 +38,204 @@ else
 fi
 echo ""
 
+echo "========================================"
+echo "Testando a interpretação (-i --tree-walker)"
+echo "========================================"
+$GPT -i --tree-walker tester.gpt
+RESULT=$?
+echo "Código de saída: $RESULT"
+if [ $RESULT -eq 42 ]; then
+	echo "✓ Interpretação (árvore sintática) OK"
+else
+	echo "✗ Interpretação (árvore sintática) FALHOU (esperado: 42)"
+	FAILURES=$((FAILURES + 1))
+fi
+echo ""
+
+echo "========================================"
+echo "Testando divisão inteira no interpretador (-i)"
+echo "========================================"
+# casos que derrubariam o processo com SIGFPE; o binario nativo ainda nao
+# os trata, por isso ficam fora do tester.gpt
+cat >tester_div.gpt <<'FIM'
+algoritmo tester_div;
+variáveis
+  x, y : inteiro;
+fim-variáveis
+início
+  x := -2147483647 - 1;
+  y := -1;
+  se x / y <> x ou x % y <> 0 então
+    retorne 1;
+  fim-se
+  y := 0;
+  imprima(x % y);
+fim
+FIM
+for ENGINE in "" "--tree-walker"; do
+	OUTPUT=$($GPT -i $ENGINE tester_div.gpt 2>&1)
+	RESULT=$?
+	echo "Código de saída: $RESULT"
+	if [ $RESULT -eq 1 ] && echo "$OUTPUT" | grep -q "Divisão por 0 é ilegal"; then
+		echo "✓ Divisão inteira $ENGINE OK"
+	else
+		echo "✗ Divisão inteira $ENGINE FALHOU (esperado: erro de divisão por 0)"
+		FAILURES=$((FAILURES + 1))
+	fi
+done
+rm -f tester_div.gpt
+echo ""
+
+echo "========================================"
+echo "Testando limites de execução (-i --max-steps)"
+echo "========================================"
+cat >tester_limite.gpt <<'FIM'
+algoritmo tester_limite;
+variáveis
+  i : inteiro;
+fim-variáveis
+início
+  i := 0;
+  enquanto verdadeiro faça
+    i := i + 1;
+  fim-enquanto
+fim
+FIM
+for ENGINE in "" "--tree-walker"; do
+	OUTPUT=$($GPT -i $ENGINE --max-steps 1000 tester_limite.gpt 2>&1)
+	RESULT=$?
+	echo "Código de saída: $RESULT"
+	if [ $RESULT -eq 3 ] && echo "$OUTPUT" | grep -q "Limite de 1000 passos de execução excedido"; then
+		echo "✓ Limite de passos $ENGINE OK"
+	else
+		echo "✗ Limite de passos $ENGINE FALHOU (esperado: 3 e limite excedido)"
+		FAILURES=$((FAILURES + 1))
+	fi
+done
+
+# um algoritmo pode terminar com "retorne 3": so a mensagem o distingue
+cat >tester_retorne3.gpt <<'FIM'
+algoritmo tester_retorne3;
+início
+  retorne 3;
+fim
+FIM
+OUTPUT=$($GPT -i --max-steps 1000 tester_retorne3.gpt 2>&1)
+RESULT=$?
+echo "Código de saída: $RESULT"
+if [ $RESULT -eq 3 ] && ! echo "$OUTPUT" | grep -q "Execução interrompida"; then
+	echo "✓ retorne 3 OK"
+else
+	echo "✗ retorne 3 FALHOU (esperado: 3 sem limite excedido)"
+	FAILURES=$((FAILURES + 1))
+fi
+echo ""
+
+echo "========================================"
+echo "Testando estatísticas (-i --stats)"
+echo "========================================"
+OUTPUT=$($GPT -i --stats tester.gpt 2>&1 >/dev/null)
+RESULT=$?
+echo "Código de saída: $RESULT"
+if [ $RESULT -eq 42 ] && echo "$OUTPUT" | grep -q '"resultado": "ok".*"passos": '; then
+	echo "✓ Estatísticas OK"
+else
+	echo "✗ Estatísticas FALHOU (esperado: 42 e objeto JSON na saída de erros)"
+	FAILURES=$((FAILURES + 1))
+fi
+echo ""
+
+echo "========================================"
+echo "Testando execução em lote (--batch)"
+echo "========================================"
+printf 'programa tester.gpt\nprograma tester_limite.gpt\nprograma tester_retorne3.gpt\n' >tester_lote.txt
+OUTPUT=$($GPT --batch tester_lote.txt --max-steps 1000000 --jobs 2)
+RESULT=$?
+echo "Código de saída: $RESULT"
+if [ $RESULT -eq 0 ] && [ "$(echo "$OUTPUT" | wc -l)" -eq 3 ] &&
+	echo "$OUTPUT" | grep '"programa": "tester.gpt"' | grep -q '"resultado": "ok", "codigo_saida": 42' &&
+	echo "$OUTPUT" | grep '"programa": "tester_limite.gpt"' | grep -q '"resultado": "limite", "codigo_saida": 3' &&
+	echo "$OUTPUT" | grep '"programa": "tester_retorne3.gpt"' | grep -q '"resultado": "ok", "codigo_saida": 3'; then
+	echo "✓ Execução em lote OK"
+else
+	echo "✗ Execução em lote FALHOU"
+	echo "$OUTPUT"
+	FAILURES=$((FAILURES + 1))
+fi
+rm -f tester_limite.gpt tester_retorne3.gpt tester_lote.txt
+echo ""
+
+echo "========================================"
+echo "Testando o cache de compilação (-s)"
+echo "========================================"
+CACHE_DIR=$(mktemp -d)
+GPT_CACHE_DIR=$CACHE_DIR $GPT -s tester_cache1.asm tester.gpt
+GPT_CACHE_DIR=$CACHE_DIR $GPT -s tester_cache2.asm tester.gpt
+GPT_CACHE_DIR=$CACHE_DIR $GPT --no-cache -s tester_cache3.asm tester.gpt
+if [ -n "$(ls -A "$CACHE_DIR")" ] && cmp -s tester_cache1.asm tester_cache2.asm &&
+	cmp -s tester_cache1.asm tester_cache3.asm; then
+	echo "✓ Cache de compilação OK"
+else
+	echo "✗ Cache de compilação FALHOU"
+	FAILURES=$((FAILURES + 1))
+fi
+rm -rf "$CACHE_DIR" tester_cache1.asm tester_cache2.asm tester_cache3.asm
+echo ""
+
+echo "========================================"
+echo "Testando arquivos pré-compilados (--precompile)"
+echo "========================================"
+cat >tester_lib.gpt <<'FIM'
+função quarenta_e_dois() : inteiro
+início
+  retorne 42;
+fim
+FIM
+cat >tester_lib_main.gpt <<'FIM'
+algoritmo tester_lib_main;
+início
+  retorne quarenta_e_dois();
+fim
+FIM
+PRE_OK=1
+if ! $GPT --precompile tester_lib.gptc tester_lib.gpt || [ ! -s tester_lib.gptc ]; then
+	echo "✗ --precompile não gerou tester_lib.gptc"
+	PRE_OK=0
+fi
+# com o .gptc correspondente, desatualizado, truncado e corrompido: o
+# resultado deve ser o mesmo, e o .gptc invalido deve ser refeito
+for CASO in valido desatualizado truncado corrompido; do
+	case $CASO in
+	desatualizado) echo "/* alterado */" >>tester_lib.gpt ;;
+	truncado) head -c 20 tester_lib.gptc >tester_lib.tmp && mv tester_lib.tmp tester_lib.gptc ;;
+	corrompido) head -c "$(wc -c <tester_lib.gptc)" /dev/urandom >tester_lib.tmp && mv tester_lib.tmp tester_lib.gptc ;;
+	esac
+	cp tester_lib.gptc tester_lib.antes
+	GPT_INCLUDE=tester_lib.gpt $GPT -i tester_lib_main.gpt
+	RESULT=$?
+	echo "Código de saída ($CASO): $RESULT"
+	if [ $RESULT -ne 42 ]; then
+		echo "✗ .gptc $CASO: esperado 42"
+		PRE_OK=0
+	elif [ $CASO != valido ] && cmp -s tester_lib.gptc tester_lib.antes; then
+		echo "✗ .gptc $CASO não foi refeito"
+		PRE_OK=0
+	fi
+done
+if [ $PRE_OK -eq 1 ]; then
+	echo "✓ Arquivos pré-compilados OK"
+else
+	echo "✗ Arquivos pré-compilados FALHOU"
+	FAILURES=$((FAILURES + 1))
+fi
+rm -f tester_lib.gpt tester_lib.gptc tester_lib.antes tester_lib_main.gpt
+echo ""
+
 echo "========================================"
 echo "Testando a compilação nativa (-o)"
 echo "========================================"
-$GPT -o tester_bin tester.gpt
-if $GPT -o tester_bin tester.gpt; then
+$GPT --no-cache -o tester_bin tester.gpt
+if $GPT --no-cache -o tester_bin tester.gpt; then
 	echo "✓ Compilação OK"
 	if [ $CAN_EXEC_X86 -eq 1 ]; then
 		./tester_bin
@@ -67,8 +260,8 @@ echo ""
 echo "========================================"
 echo "Testando geração de assembly (-s)"
 echo "========================================"
-$GPT -s tester.asm tester.gpt
-if $GPT -s tester.asm tester.gpt && [ -f tester.asm ]; then
+$GPT --no-cache -s tester.asm tester.gpt
+if $GPT --no-cache -s tester.asm tester.gpt && [ -f tester.asm ]; then
 	echo "✓ Geração de assembly OK"
 	# Check if we can assemble it
 	if command -v nasm &>/dev/null; then
@@ -89,11 +282,41 @@ else
 fi
 echo ""
 
+echo "========================================"
+echo "Testando compilação separada (-s --separate)"
+echo "========================================"
+cat >tester_sep_ok.gpt <<'FIM'
+algoritmo tester_sep_ok;
+início
+  retorne 42;
+fim
+FIM
+printf 'algoritmo tester_sep_erro1;\ninício\n  x := 1;\nfim\n' >tester_sep_erro1.gpt
+printf 'algoritmo tester_sep_erro2;\ninício\n  y := 1;\nfim\n' >tester_sep_erro2.gpt
+SEP_DIR=$(mktemp -d)
+OUTPUT=$($GPT --no-cache --separate --jobs 2 -s "$SEP_DIR" tester.gpt \
+	tester_sep_erro1.gpt tester_sep_ok.gpt tester_sep_erro2.gpt 2>&1)
+RESULT=$?
+echo "Código de saída: $RESULT"
+ERRO1=$(echo "$OUTPUT" | grep -n '^tester_sep_erro1.gpt:' | head -1 | cut -d: -f1)
+ERRO2=$(echo "$OUTPUT" | grep -n '^tester_sep_erro2.gpt:' | head -1 | cut -d: -f1)
+if [ $RESULT -ne 0 ] && [ -f "$SEP_DIR/tester.asm" ] &&
+	[ -f "$SEP_DIR/tester_sep_ok.asm" ] && [ ! -f "$SEP_DIR/tester_sep_erro1.asm" ] &&
+	[ -n "$ERRO1" ] && [ -n "$ERRO2" ] && [ "$ERRO1" -lt "$ERRO2" ]; then
+	echo "✓ Compilação separada OK"
+else
+	echo "✗ Compilação separada FALHOU (esperado: erro, saídas dos arquivos válidos e erros na ordem dos arquivos)"
+	echo "$OUTPUT"
+	FAILURES=$((FAILURES + 1))
+fi
+rm -rf "$SEP_DIR" tester_sep_ok.gpt tester_sep_erro1.gpt tester_sep_erro2.gpt
+echo ""
+
 echo "========================================"
 echo "Testando tradução para C (-t)"
 echo "========================================"
-$GPT -t tester.c tester.gpt 2>&1
-if $GPT -t tester.c tester.gpt && [ -f tester.c ]; then
+$GPT --no-cache -t tester.c tester.gpt 2>&1
+if $GPT --no-cache -t tester.c tester.gpt && [ -f tester.c ]; then
 	echo "✓ Tradução para C OK"
 	rm -f tester.c
 else